@@ -2248,6 +2248,11 @@ projects/compass2/tests/checkers/asynchronous_signal_handler/compass_parameters.
 projects/compass2/tests/checkers/asynchronous_signal_handler/Makefile
 projects/compass2/tests/Makefile
 projects/compass2/tests/checkers/Makefile
+projects/compass2/tests/traversal/Makefile
+projects/compass2/tests/traversal/fused_parameters.xml
+projects/compass2/tests/traversal/standalone_parameters.xml
+projects/compass2/tests/traversal/threads1_parameters.xml
+projects/compass2/tests/traversal/threads4_parameters.xml
 projects/compass2/tests/checkers/no_vfork/Makefile
 projects/compass2/tests/checkers/no_vfork/compass_parameters.xml
 projects/compass2/tests/checkers/no_variadic_functions/Makefile
@@ -1418,7 +1418,8 @@ public:
     State<ValueType> state;
     static const rose_addr_t FUNC_RET_ADDR = 4083;      // Special return address to mark end of analysis
     InputGroup *inputs;                                 // Input values to use when reading a never-before-written variable
-    const PointerDetector *pointers;                    // Addresses of pointer variables, or null if not analyzed
+    const PointerDetector *pointers;                    // Addresses of pointer variables, or null if not analyzed.
+                                                        // Queried without locking, so not shared across threads.
     SgAsmInterpretation *interp;                        // Interpretation in which we're executing
     size_t ninsns;                                      // Number of instructions processed since last trigger() call
     AddressHasher address_hasher;                       // Hashes a virtual address
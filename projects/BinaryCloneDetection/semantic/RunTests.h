@@ -50,6 +50,19 @@ struct WorkItem {
 
 std::ostream& operator<<(std::ostream&, const WorkItem&);
 
+// Everything needed for a row of the semantic_fio table except the output group ID and command ID.
+struct TestResult {
+    WorkItem workItem;
+    OutputGroup ogroup;
+    size_t arguments_consumed, locals_consumed, globals_consumed, functions_consumed, pointers_consumed, integers_consumed;
+    double elapsed_time, cpu_time;
+    std::string counts_b64;
+    int syntactic_ninsns;
+    TestResult()
+        : arguments_consumed(0), locals_consumed(0), globals_consumed(0), functions_consumed(0), pointers_consumed(0),
+          integers_consumed(0), elapsed_time(0.0), cpu_time(0.0), syntactic_ninsns(0) {}
+};
+
 typedef std::vector<WorkItem> Work;
 typedef std::vector<Work> MultiWork;
 typedef std::map<SgAsmFunction*, PointerDetector*> PointerDetectors;
@@ -84,6 +97,16 @@ void runOneTest(SqlDatabase::TransactionPtr tx, const WorkItem &workItem, Pointe
                 FuncAnalyses funcinfo, const InstructionProvidor &insns, MemoryMap *ro_map, const AddressIdMap &entry2id,
                 OutputGroups &ogroups /*in,out*/);
 
+// Runs one test without touching the database.  This is the part of runOneTest that can run concurrently in multiple
+// threads, provided each thread has its own tracer, coverage, call graph, consumed inputs, input group, analyses, and memory
+// map.
+TestResult executeOneTest(const WorkItem &workItem, const PointerDetector *pointers, SgAsmFunction *func,
+                          InsnCoverage &insn_coverage /*in,out*/, DynamicCallGraph &dynamic_cg /*in,out*/,
+                          Tracer &tracer /*in,out*/, ConsumedInputs &consumed_inputs /*in,out*/, SgAsmInterpretation *interp,
+                          const rose::BinaryAnalysis::Disassembler::AddressSet &whitelist_exports, InputGroup &igroup,
+                          FuncAnalyses &funcinfo /*in,out*/, const InstructionProvidor &insns, MemoryMap *ro_map,
+                          const AddressIdMap &entry2id);
+
 } // namespace
 } // namespace
 
@@ -282,8 +282,9 @@ else
     if [ "$interactive" = "yes" ]; then
 	echo
 	echo "=================================================================================================="
-	echo "Would you like to run the 25-run-tests-fork rather than 25-run-tests?  The fork version of the"
-	echo "command handles its perallelism internally by forking new processes, while the non-fork version"
+	echo "Would you like to run the 25-run-tests-fork or 25-run-tests-threads rather than 25-run-tests?"
+	echo "The fork version of the command handles its perallelism internally by forking new processes, the"
+	echo "threads version runs tests in parallel threads of a single process, while the non-fork version"
 	echo "uses a parallel makefile (which will be generated automatically)."
 	echo
 	[ "$run_tests_cmd" = "" ] && run_tests_cmd="25-run-tests";
@@ -300,7 +301,7 @@ else
 	save_settings
     fi
 
-    if [ "$run_tests_cmd" = "25-run-tests-fork" ]; then
+    if [ "$run_tests_cmd" = "25-run-tests-fork" -o "$run_tests_cmd" = "25-run-tests-threads" ]; then
 	execute $BLDDIR/$run_tests_cmd $run_tests_flags "$dbname" <$worklist || exit 1
 	rm -f $worklist;
     else
@@ -0,0 +1,141 @@
+#ifndef LSH_INDEX_H
+#define LSH_INDEX_H
+
+// Memory-resident locality sensitive hashing index over syntactic signature vectors.
+//
+// The LSHTable in lsh.h is built once from vectors read out of the database by each lshCloneDetection process, and its
+// hash functions depend on the range of all vectors, so it can't be extended.  LSHIndex is meant to be built once, kept in
+// memory (or in a file), and extended as new functions are added:
+//
+//   * Hash functions are p-stable projections (Cauchy for the l_1 norm, Gaussian for l_2) that don't depend on the data, so
+//     vectors can be inserted at any time.
+//   * Signature vectors are sparse, so they're stored as one contiguous array of (dimension, count) pairs with an offset
+//     per vector rather than one heap allocation per vector.
+//   * Each hash table is a bucket head array plus one "next" link per vector, so insertion is constant time and the whole
+//     index is a handful of flat arrays.
+//   * The arrays can be saved to a file that is later mapped into memory read-only, so opening even a very large index
+//     doesn't read it.  Inserting into a mapped index first copies it into memory.
+//
+// Distances and projections are computed with SSE2 when the compiler supports it.
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <stdint.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+class LSHIndex {
+public:
+    /** Parameters that determine the hash functions. */
+    struct Params {
+        size_t numVectorElements;       /**< Dimension of the vectors. */
+        int norm;                       /**< Distance norm: 1 or 2. */
+        size_t k;                       /**< Number of projections combined into each hash function. */
+        size_t l;                       /**< Number of hash tables. */
+        double r;                       /**< Width of the projection intervals. */
+        size_t numBuckets;              /**< Number of buckets per hash table. */
+        uint32_t seed;                  /**< Random number generator seed for the projections. */
+        Params(): numVectorElements(0), norm(1), k(20), l(30), r(4.0), numBuckets(1000003), seed(0) {}
+    };
+
+    /** Information about a vector, from the "vectors" table. */
+    struct Entry {
+        uint64_t rowNumber;             /**< Value of the "id" column. */
+        uint64_t line;
+        uint32_t functionId;
+        uint32_t indexWithinFunction;
+        uint32_t offset;
+        uint32_t reserved;
+        Entry(): rowNumber(0), line(0), functionId(0), indexWithinFunction(0), offset(0), reserved(0) {}
+    };
+
+    /** One query result: index of a stored vector and its distance from the query vector. */
+    typedef std::pair<size_t, double> Match;
+
+private:
+    Params params;
+    size_t nVectors;
+
+    // Owned storage. These are empty when the index is mapped from a file.
+    std::vector<Entry> ownedEntries;
+    std::vector<uint64_t> ownedOffsets;                 // nVectors+1 offsets into the dims and counts arrays
+    std::vector<uint16_t> ownedDims;                    // dimension of each nonzero element
+    std::vector<uint16_t> ownedCounts;                  // value of each nonzero element
+    std::vector<float> ownedProjections;                // numVectorElements rows of l*k projection coefficients
+    std::vector<float> ownedBiases;                     // l*k offsets in [0,r)
+    std::vector<uint32_t> ownedCoeffs;                  // l*k multipliers combining projections into a bucket number
+    std::vector<uint32_t> ownedHeads;                   // l*numBuckets first vector in each bucket
+    std::vector<uint32_t> ownedNext;                    // nVectors*l next vector in the same bucket
+
+    // Views of the arrays, pointing either into the owned storage or into the mapped file.
+    const Entry *entries;
+    const uint64_t *offsets;
+    const uint16_t *dims;
+    const uint16_t *counts;
+    const float *projections;
+    const float *biases;
+    const uint32_t *coeffs;
+    const uint32_t *heads;
+    const uint32_t *next;
+
+    boost::shared_ptr<boost::iostreams::mapped_file_source> mapping;
+
+public:
+    /** Creates an empty index. */
+    explicit LSHIndex(const Params&);
+
+    /** Opens an index saved by @ref save. The file is mapped into memory read-only. Throws std::runtime_error if the file is
+     *  not a valid index. */
+    explicit LSHIndex(const std::string &fileName);
+
+    /** Saves the index so it can be opened by the file name constructor. */
+    void save(const std::string &fileName) const;
+
+    const Params& parameters() const { return params; }
+
+    /** Number of vectors in the index. */
+    size_t size() const { return nVectors; }
+
+    /** True if the index is mapped from a file rather than held in memory. */
+    bool isMapped() const { return mapping != NULL; }
+
+    /** Information about a stored vector. */
+    const Entry& entry(size_t i) const { return entries[i]; }
+
+    /** Largest row number of any stored vector, or zero if the index is empty. */
+    uint64_t maxRowNumber() const;
+
+    /** Inserts a vector and returns its index.  The vector is given either uncompressed (numVectorElements counts) or in
+     *  the compressed form stored in the database (see vectorCompression.h).
+     * @{ */
+    size_t insert(const Entry&, const uint16_t *vector);
+    size_t insertCompressed(const Entry&, const uint8_t *compressed, size_t compressedSize);
+    /** @} */
+
+    /** Returns stored vectors that share a bucket with the query vector and are within @p maxDistance of it, sorted by
+     *  index.  The query vector is given uncompressed, compressed, or as the index of a stored vector.
+     * @{ */
+    std::vector<Match> query(const uint16_t *vector, double maxDistance) const;
+    std::vector<Match> queryCompressed(const uint8_t *compressed, size_t compressedSize, double maxDistance) const;
+    std::vector<Match> query(size_t i, double maxDistance) const;
+    /** @} */
+
+    /** Approximate number of bytes occupied by the index. */
+    size_t memoryUsage() const;
+
+private:
+    LSHIndex(const LSHIndex&);                          // not copyable
+    LSHIndex& operator=(const LSHIndex&);
+
+    void createHashFunctions();
+    void makeWritable();
+    void updateViews();
+    void computeBuckets(const uint16_t *dims, const uint16_t *counts, size_t nNonzero, std::vector<size_t> &buckets) const;
+    size_t insertSparse(const Entry&, const std::vector<uint16_t> &dims, const std::vector<uint16_t> &counts);
+    std::vector<Match> querySparse(const uint16_t *dims, const uint16_t *counts, size_t nNonzero, double maxDistance) const;
+    double distance(const std::vector<double> &dense, double denseNorm, size_t i) const;
+};
+
+#endif
@@ -143,6 +143,7 @@ namespace CodeThorn {
     void runSolver2();
     void runSolver3();
     void runSolver4();
+    void runSolver5();
     void runSolver();
     //! The analyzer requires a CFAnalyzer to obtain the ICFG.
     void setCFAnalyzer(CFAnalyzer* cf) { cfanalyzer=cf; }
@@ -199,7 +200,7 @@ namespace CodeThorn {
     InputOutput::OpType ioOp(const EState* estate) const;
     
     void setDisplayDiff(int diff) { _displayDiff=diff; }
-    void setSolver(int solver) { _solver=solver; ROSE_ASSERT(_solver>=1 && _solver<=4);}
+    void setSolver(int solver) { _solver=solver; ROSE_ASSERT(_solver>=1 && _solver<=5);}
     int getSolver() { return _solver;}
     void setSemanticFoldThreshold(int t) { _semanticFoldThreshold=t; }
     void setLTLVerifier(int v) { _ltlVerifier=v; }
@@ -241,6 +241,9 @@ class HSet {
 #endif
             temp = find(P); // redefine temp
             inserted = true;
+            // insertions into different chains may run in
+            // parallel (see HSetMaintainer)
+            #pragma omp atomic
             ++count;
         }
         return std::make_pair(temp, inserted);
@@ -315,6 +318,8 @@ class HSet {
     }
 
     size_type size()     const { return count;}
+    // address of the chain that holds (or would hold) k
+    size_type hash_address(const Key& k) const { return hf(k);}
 
     size_type max_size() const { return v.size();}
 
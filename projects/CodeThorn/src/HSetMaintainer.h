@@ -8,10 +8,18 @@
  *************************************************************/
 
 #include "HSet.h"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 using namespace br_stl;
 //#include "/usr/include/valgrind/memcheck.h"
 //#define HSET_MAINTAINER_DEBUG_MODE
 
+// number of locks protecting the chains of the hash set. Chain i is
+// protected by lock i%HSET_MAINTAINER_NUM_LOCKS, therefore threads
+// processing keys in different chains do not block each other.
+#define HSET_MAINTAINER_NUM_LOCKS 64
+
 /*! 
   * \author Markus Schordan
   * \date 2012.
@@ -20,6 +28,13 @@ template<typename KeyType,typename HashFun>
 class HSetMaintainer : public HSet<KeyType,HashFun> {
 public:
   typedef pair<bool,const KeyType*> ProcessingResult;
+  HSetMaintainer() { initLocks(); }
+  HSetMaintainer(const HSetMaintainer& other):HSet<KeyType,HashFun>(other) { initLocks(); }
+  HSetMaintainer& operator=(const HSetMaintainer& other) {
+    HSet<KeyType,HashFun>::operator=(other);
+    return *this;
+  }
+  ~HSetMaintainer() { destroyLocks(); }
   bool exists(KeyType& s) { 
     return determine(s)!=0;
   }
@@ -44,7 +59,10 @@ public:
 
   KeyType* determine(KeyType& s) { 
     typename HSetMaintainer<KeyType,HashFun>::iterator i;
+    size_t lockNum=lockNumber(s);
+    lock(lockNum);
     i=HSetMaintainer<KeyType,HashFun>::find(s);
+    unlock(lockNum);
     if(i!=HSetMaintainer<KeyType,HashFun>::end()) {
       return const_cast<KeyType*>(&(*i));
     } else {
@@ -54,7 +72,10 @@ public:
 
   const KeyType* determine(const KeyType& s) { 
     typename HSetMaintainer<KeyType,HashFun>::iterator i;
+    size_t lockNum=lockNumber(s);
+    lock(lockNum);
     i=HSetMaintainer<KeyType,HashFun>::find(s);
+    unlock(lockNum);
     if(i!=HSetMaintainer<KeyType,HashFun>::end()) {
       return &(*i);
     } else {
@@ -66,7 +87,8 @@ public:
   //! <false,const KeyType> if element already existed
   ProcessingResult process(KeyType key) {
     ProcessingResult res2;
-    #pragma omp critical
+    size_t lockNum=lockNumber(key);
+    lock(lockNum);
     {
     std::pair<typename HSetMaintainer::iterator, bool> res;
     res=insert(key);
@@ -85,6 +107,7 @@ public:
 #endif
     res2=make_pair(res.second,&(*res.first));
     }
+    unlock(lockNum);
     return res2;
   }
   const KeyType* processNew(KeyType& s) {
@@ -126,6 +149,34 @@ public:
 
  private:
   const KeyType* ptr(KeyType& s) {}
+  size_t lockNumber(const KeyType& s) const {
+    return HSetMaintainer<KeyType,HashFun>::hash_address(s)%HSET_MAINTAINER_NUM_LOCKS;
+  }
+  void initLocks() {
+#ifdef _OPENMP
+    for(int i=0;i<HSET_MAINTAINER_NUM_LOCKS;++i)
+      omp_init_lock(&_locks[i]);
+#endif
+  }
+  void destroyLocks() {
+#ifdef _OPENMP
+    for(int i=0;i<HSET_MAINTAINER_NUM_LOCKS;++i)
+      omp_destroy_lock(&_locks[i]);
+#endif
+  }
+  void lock(size_t lockNum) {
+#ifdef _OPENMP
+    omp_set_lock(&_locks[lockNum]);
+#endif
+  }
+  void unlock(size_t lockNum) {
+#ifdef _OPENMP
+    omp_unset_lock(&_locks[lockNum]);
+#endif
+  }
+#ifdef _OPENMP
+  omp_lock_t _locks[HSET_MAINTAINER_NUM_LOCKS];
+#endif
 };
 
 #endif
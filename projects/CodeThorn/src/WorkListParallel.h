@@ -0,0 +1,68 @@
+#ifndef WORKLIST_PARALLEL_H
+#define WORKLIST_PARALLEL_H
+
+/*************************************************************
+ * License  : see file LICENSE in the CodeThorn distribution *
+ *************************************************************/
+
+#include <deque>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace CodeThorn {
+
+/*!
+  * \brief Work list for parallel solvers with one deque per thread.
+
+  A thread adds the elements it produces to its own deque and takes
+  elements from the front of it (breadth first). When its own deque is
+  empty it steals half of the elements of another thread's deque,
+  taken from the back. Each deque has its own lock, so threads only
+  contend with each other when they steal.
+
+  The work list counts the elements that are queued or are being
+  processed. A thread that has taken an element must call done() after
+  it has added all successors of that element. The solver is finished
+  when isFinished() is true, i.e. no element is queued and no thread
+  is processing one.
+ */
+template <typename Element>
+class WorkListParallel {
+ public:
+  WorkListParallel(int numberOfThreads);
+  ~WorkListParallel();
+  int numberOfThreads() const { return (int)_queues.size(); }
+  void add(int threadNum, Element elem);
+  bool take(int threadNum, Element& elem);
+  void done();
+  bool isFinished();
+  size_t size();
+  long numberOfSteals() const { return _steals; }
+ private:
+  // not copyable (owns locks)
+  WorkListParallel(const WorkListParallel&);
+  WorkListParallel& operator=(const WorkListParallel&);
+  bool steal(int threadNum, Element& elem);
+  void lock(int queueNum);
+  void unlock(int queueNum);
+  struct Queue {
+    std::deque<Element> elements;
+#ifdef _OPENMP
+    omp_lock_t lock;
+#endif
+    char padding[64]; // keep locks of different threads in different cache lines
+  };
+  std::vector<Queue*> _queues;
+  long _pending;
+  long _steals;
+};
+
+} // end of namespace CodeThorn
+
+// template implementation code
+#include "WorkListParallel.C"
+
+#endif
@@ -60,6 +60,27 @@ bool IsNodeNotInUserLocation(const SgNode* node)
   }
 };
 
+/**
+ * \brief Specification of AST traversal.
+ */
+class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+ public:
+  Traversal(Compass::Parameters inputParameters,
+            Compass::OutputObject *output);
+
+  void run(SgNode *n)
+  {
+    this->traverse(n, preorder);
+  }
+
+  void visit(SgNode *n);
+
+ private:
+  Compass::OutputObject* output_;
+
+  DISALLOW_COPY_AND_ASSIGN(Traversal);
+};
+
 } // ::CompassAnalyses
 } // ::AsynchronousSignalHandler
 #endif // COMPASS_ASYNCHRONOUS_SIGNAL_HANDLER_H
@@ -102,8 +123,9 @@ CheckerOutput::CheckerOutput(SgNode *const node)
 boost::unordered_set<std::string> async_safe;
 bool first_run = true;
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::AsynchronousSignalHandler::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
 {
   // We only care about source code in the user's space, not,
   // for example, Boost or system files.
@@ -111,10 +133,8 @@ run(Compass::Parameters parameters, Compass::OutputObject* output)
       parameters["general::target_directory"].front();
   CompassAnalyses::AsynchronousSignalHandler::source_directory.assign(target_directory);
 
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode *root_node = (SgNode *)sageProject;
-
+  // Filled when the first traversal is created, and only read while the
+  // AST is walked.
   if(first_run)
   {
     first_run = false;
@@ -237,66 +257,69 @@ run(Compass::Parameters parameters, Compass::OutputObject* output)
     async_safe.insert("waitpid");
     async_safe.insert("write");
   }
+}
+
+void
+CompassAnalyses::AsynchronousSignalHandler::Traversal::
+visit(SgNode* node)
+{
+  // Derived definitions, such as those of template instantiations, are not
+  // checked.
+  if (node->variantT() != V_SgFunctionDefinition)
+    return;
 
+  SgFunctionDefinition *parent_func_def = isSgFunctionDefinition(node);
 
-  AstMatching func_def_matcher;
-  MatchResult func_def_matches = func_def_matcher
-      .performMatching("$f=SgFunctionDefinition", root_node);
-  BOOST_FOREACH(SingleMatchVarBindings func_def_match, func_def_matches)
+  AstMatching func_call_matcher;
+  MatchResult func_call_matches = func_call_matcher
+      .performMatching("$f=SgFunctionCallExp", parent_func_def);
+  bool marked = false;
+  std::vector<SgFunctionCallExp*> failed_calls;
+  BOOST_FOREACH(SingleMatchVarBindings func_call_match, func_call_matches)
   {
+    SgFunctionCallExp *func_call = (SgFunctionCallExp *)func_call_match["$f"];
+    SgFunctionRefExp *func_ref = (SgFunctionRefExp *)func_call->get_traversalSuccessorByIndex(0);
+    if(func_ref == NULL) continue;
+    SgFunctionDeclaration *func_dec = func_call->getAssociatedFunctionDeclaration();
+    if(func_dec == NULL) continue;
+    SgExprListExp *func_args = func_call->get_args();
+    if(func_args == NULL) continue;
 
-    SgFunctionDefinition *parent_func_def =
-        (SgFunctionDefinition *)func_def_match["$f"];
-
-    AstMatching func_call_matcher;
-    MatchResult func_call_matches = func_call_matcher
-        .performMatching("$f=SgFunctionCallExp", parent_func_def);
-    bool marked = false;
-    std::vector<SgFunctionCallExp*> failed_calls;
-    BOOST_FOREACH(SingleMatchVarBindings func_call_match, func_call_matches)
+    if((func_args->get_expressions().size() == 2) &&
+        (func_dec->get_definingDeclaration() == NULL) &&
+        (func_dec->get_name() == "signal"))
     {
-      SgFunctionCallExp *func_call = (SgFunctionCallExp *)func_call_match["$f"];
-      SgFunctionRefExp *func_ref = (SgFunctionRefExp *)func_call->get_traversalSuccessorByIndex(0);
-      if(func_ref == NULL) continue;
-      SgFunctionDeclaration *func_dec = func_call->getAssociatedFunctionDeclaration();
-      if(func_dec == NULL) continue;
-      SgExprListExp *func_args = func_call->get_args();
-      if(func_args == NULL) continue;
-
-      if((func_args->get_expressions().size() == 2) &&
-          (func_dec->get_definingDeclaration() == NULL) &&
-          (func_dec->get_name() == "signal"))
-      {
-        // the parent function contains a signal() call
-        marked = true;
-      }
+      // the parent function contains a signal() call
+      marked = true;
+    }
 
-      if(async_safe.find(func_dec->get_name().getString()) == async_safe.end())
-      {
-        // this is not an async safe function!
-        failed_calls.push_back(func_call);
-      }
+    if(async_safe.find(func_dec->get_name().getString()) == async_safe.end())
+    {
+      // this is not an async safe function!
+      failed_calls.push_back(func_call);
     }
-    if(marked)
+  }
+  if(marked)
+  {
+    BOOST_FOREACH(SgFunctionCallExp *func_call, failed_calls)
     {
-      BOOST_FOREACH(SgFunctionCallExp *func_call, failed_calls)
-      {
-        output->addOutput(
-            new CompassAnalyses::AsynchronousSignalHandler::
-            CheckerOutput(func_call));
-      }
+      output_->addOutput(new CheckerOutput(func_call));
     }
   }
 }
 
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+{
+  // Use the pre-built ROSE AST
+  CompassAnalyses::AsynchronousSignalHandler::Traversal(parameters, output).run(
+    Compass::projectPrerequisite.getProject());
+}
 
-
-
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
 {
-  return NULL;
+  return new CompassAnalyses::AsynchronousSignalHandler::Traversal(params, output);
 }
 
 extern const Compass::Checker* const asynchronousSignalHandlerChecker =
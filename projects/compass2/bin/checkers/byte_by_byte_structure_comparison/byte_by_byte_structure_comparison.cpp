@@ -60,6 +60,27 @@ namespace ByteByByteStructureComparison
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::ByteByByteStructureComparison
 #endif // COMPASS_BYTE_BY_BYTE_STRUCTURE_COMPARISON_H
@@ -85,48 +106,59 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::byteByByteStructureComparisonChecker->checkerName,
                           ::byteByByteStructureComparisonChecker->shortDescription) {}
 
+CompassAnalyses::ByteByByteStructureComparison::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::ByteByByteStructureComparison::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::ByteByByteStructureComparison::Traversal::
+visit(SgNode* node)
+  {
+    // Derived calls, such as CUDA kernel calls, are not checked.
+    if (node->variantT() != V_SgFunctionCallExp)
+      return;
+
+    // Direct calls with three arguments
+    SgFunctionCallExp* function_call = isSgFunctionCallExp(node);
+    if (isSgFunctionRefExp(function_call->get_function()) == NULL ||
+        function_call->get_args() == NULL ||
+        function_call->get_args()->get_expressions().size() != 3)
+      return;
+    if ("memcmp" != function_call->getAssociatedFunctionDeclaration()->get_name().getString())
+      return;
+
+    AstMatching match_vars;
+    MatchResult result_vars = match_vars.performMatching("$s = SgVarRefExp", function_call);
+    bool struct_used = false;
+    BOOST_FOREACH(SingleMatchVarBindings var_match, result_vars)
+      {
+        SgVarRefExp* var = (SgVarRefExp*)var_match["$s"];
+        if (isSgClassType(var->get_type()->findBaseType()) != NULL)
+          struct_used = true;
+      }
+    if (struct_used)
+      output_->addOutput(new CheckerOutput(function_call));
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::ByteByByteStructureComparison::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_functions;
-      MatchResult result_functions =
-	match_functions.performMatching("$r = SgFunctionCallExp(SgFunctionRefExp,SgExprListExp(_,_,_))", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_functions)
-	{
-	  SgFunctionCallExp* function_call = (SgFunctionCallExp*)match["$r"];
-	  AstMatching match_vars;
-	  MatchResult result_vars;
-	  if ("memcmp" == function_call->getAssociatedFunctionDeclaration()->get_name().getString())
-	    result_vars = match_vars.performMatching("$s = SgVarRefExp", function_call);
-	  else
-	    continue;
-	  bool struct_used = false;
-	  BOOST_FOREACH(SingleMatchVarBindings var_match, result_vars)
-	    {
-	      SgVarRefExp* var = (SgVarRefExp*)var_match["$s"];
-	      if (isSgClassType(var->get_type()->findBaseType()) != NULL)
-		struct_used = true;
-	    }
-	  if (struct_used)
-	    output->addOutput(new CompassAnalyses::ByteByByteStructureComparison::CheckerOutput(function_call));
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::ByteByByteStructureComparison::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::ByteByByteStructureComparison::Traversal(params, output);
   }
 
 extern const Compass::Checker* const byteByByteStructureComparisonChecker =
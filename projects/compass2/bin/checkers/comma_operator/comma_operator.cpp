@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace CommaOperator
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::CommaOperator
 #endif // COMPASS_COMMA_OPERATOR_H
@@ -85,34 +105,41 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::commaOperatorChecker->checkerName,
                           ::commaOperatorChecker->shortDescription) {}
 
+CompassAnalyses::CommaOperator::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::CommaOperator::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::CommaOperator::Traversal::
+visit(SgNode* node)
+  {
+    SgCommaOpExp* op = isSgCommaOpExp(node);
+    if (op != NULL)
+    {
+        output_->addOutput(new CheckerOutput(op));
+    }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::CommaOperator::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_comma;
-      MatchResult results_comma = match_comma.performMatching("$r = SgCommaOpExp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, results_comma)
-	{
-	  SgCommaOpExp* op = (SgCommaOpExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::CommaOperator::CheckerOutput(op));
-	}
-      
+    // Use the pre-built ROSE AST
+    CompassAnalyses::CommaOperator::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
 // Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::CommaOperator::Traversal(params, output);
   }
 
 extern const Compass::Checker* const commaOperatorChecker =
@@ -124,5 +151,6 @@ extern const Compass::Checker* const commaOperatorChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
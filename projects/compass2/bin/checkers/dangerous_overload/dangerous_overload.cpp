@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace DangerousOverload
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::DangerousOverload
 #endif // COMPASS_DANGEROUS_OVERLOAD_H
@@ -85,37 +105,45 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::dangerousOverloadChecker->checkerName,
                           ::dangerousOverloadChecker->shortDescription) {}
 
+CompassAnalyses::DangerousOverload::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::DangerousOverload::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::DangerousOverload::Traversal::
+visit(SgNode* node)
+  {
+    // Derived declarations, such as template instantiations, are not checked.
+    if (node->variantT() != V_SgMemberFunctionDeclaration)
+      return;
+
+    SgMemberFunctionDeclaration* decl = isSgMemberFunctionDeclaration(node);
+    string name = decl->get_name().getString();
+    if (name == "operator&" || name == "operator&&" || name == "operator||" || name == "operator,")
+      {
+        output_->addOutput(new CheckerOutput(decl));
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::DangerousOverload::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_member;
-      MatchResult func_matches = match_member.performMatching("$r = SgMemberFunctionDeclaration", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, func_matches)
-        {
-          SgMemberFunctionDeclaration* decl = (SgMemberFunctionDeclaration*)match["$r"];
-          string name = decl->get_name().getString();
-          if (name == "operator&" || name == "operator&&" || name == "operator||" || name == "operator,")
-            {
-              output->addOutput(new CompassAnalyses::DangerousOverload::CheckerOutput(decl));
-            }
-        }
+    // Use the pre-built ROSE AST
+    CompassAnalyses::DangerousOverload::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DangerousOverload::Traversal(params, output);
   }
 
 extern const Compass::Checker* const dangerousOverloadChecker =
@@ -127,5 +155,6 @@ extern const Compass::Checker* const dangerousOverloadChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
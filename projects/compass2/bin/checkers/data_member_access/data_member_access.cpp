@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace DataMemberAccess
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::DataMemberAccess
 #endif // COMPASS_DATA_MEMBER_ACCESS_H
@@ -85,54 +105,63 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::dataMemberAccessChecker->checkerName,
                           ::dataMemberAccessChecker->shortDescription) {}
 
+CompassAnalyses::DataMemberAccess::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::DataMemberAccess::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::DataMemberAccess::Traversal::
+visit(SgNode* node)
+  {
+    // Derived definitions, such as those of template instantiations, are not
+    // checked.
+    if (node->variantT() != V_SgClassDefinition)
+      return;
+
+    SgClassDefinition* classdef = isSgClassDefinition(node);
+    int pub, prot, priv;
+    pub = prot = priv = 0;
+    SgDeclarationStatementPtrList& members = classdef->get_members();
+    SgDeclarationStatementPtrList::iterator member;
+    for (member = members.begin(); member != members.end(); ++member)
+      {
+        SgVariableDeclaration* vardecl = isSgVariableDeclaration(*member);
+        if (vardecl != NULL)
+          {
+            SgAccessModifier &mod = vardecl->get_declarationModifier().get_accessModifier();
+            if (mod.isPublic())
+              ++pub;
+            else if (mod.isProtected())
+              ++prot;
+            else if (mod.isPrivate())
+              ++priv;
+          }
+      }
+    if (pub != 0 && prot + priv != 0)
+      {
+        output_->addOutput(new CheckerOutput(classdef));
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::DataMemberAccess::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_classes;
-      MatchResult result_classes = match_classes.performMatching("$r = SgClassDefinition", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_classes)
-	{
-	  SgClassDefinition* classdef = (SgClassDefinition*)match["$r"];
-	  int pub, prot, priv;
-	  pub = prot = priv = 0;
-	  SgDeclarationStatementPtrList members = classdef->get_members();
-	  SgDeclarationStatementPtrList::iterator member;
-	  for (member = members.begin(); member != members.end(); ++member)
-	    {
-	      SgVariableDeclaration* vardecl = isSgVariableDeclaration(*member);
-	      if (vardecl != NULL)
-		{
-		  SgAccessModifier &mod = vardecl->get_declarationModifier().get_accessModifier();
-		  if (mod.isPublic())
-		    ++pub;
-		  else if (mod.isProtected())
-		    ++prot;
-		  else if (mod.isPrivate())
-		    ++priv;
-		}
-	    }
-	  if (pub != 0 && prot + priv != 0)
-	    {
-	      output->addOutput(new CompassAnalyses::DataMemberAccess::CheckerOutput(classdef));
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::DataMemberAccess::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DataMemberAccess::Traversal(params, output);
   }
 
 extern const Compass::Checker* const dataMemberAccessChecker =
@@ -144,5 +173,6 @@ extern const Compass::Checker* const dataMemberAccessChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
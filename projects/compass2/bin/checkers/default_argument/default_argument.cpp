@@ -60,6 +60,27 @@ namespace DefaultArgument
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::DefaultArgument
 #endif // COMPASS_DEFAULT_ARGUMENT_H
@@ -85,40 +106,46 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::defaultArgumentChecker->checkerName,
                           ::defaultArgumentChecker->shortDescription) {}
 
+CompassAnalyses::DefaultArgument::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::DefaultArgument::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::DefaultArgument::Traversal::
+visit(SgNode* node)
+  {
+    SgFunctionParameterList* fpl = isSgFunctionParameterList(node);
+    if (fpl != NULL)
+      {
+        AstMatching match_assign;
+        MatchResult result_assign = match_assign.performMatching
+          ("$s = SgAssignInitializer", fpl);
+        BOOST_FOREACH(SingleMatchVarBindings new_match, result_assign)
+          {
+            output_->addOutput(new CheckerOutput(new_match["$s"]));
+          }
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::DefaultArgument::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_defarg;
-      MatchResult result_defarg = match_defarg.performMatching
-	("$r = SgFunctionParameterList", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_defarg)
-	{
-	  SgFunctionParameterList* fpl = (SgFunctionParameterList*)match["$r"];
-	  AstMatching match_assign;
-	  MatchResult result_assign = match_assign.performMatching
-	    ("$s = SgAssignInitializer", fpl);
-	  BOOST_FOREACH(SingleMatchVarBindings new_match, result_assign)
-	    {
-	      output->addOutput(new CompassAnalyses::DefaultArgument::CheckerOutput(new_match["$s"]));
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::DefaultArgument::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DefaultArgument::Traversal(params, output);
   }
 
 extern const Compass::Checker* const defaultArgumentChecker =
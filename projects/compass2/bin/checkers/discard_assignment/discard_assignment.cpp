@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace DiscardAssignment
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::DiscardAssignment
 #endif // COMPASS_DISCARD_ASSIGNMENT_H
@@ -85,36 +105,40 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::discardAssignmentChecker->checkerName,
                           ::discardAssignmentChecker->shortDescription) {}
 
+CompassAnalyses::DiscardAssignment::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::DiscardAssignment::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::DiscardAssignment::Traversal::
+visit(SgNode* node)
+  {
+    SgAssignOp* op = isSgAssignOp(node);
+    if (op != NULL && !isSgExprStatement(op->get_parent()))
+      {
+        output_->addOutput(new CheckerOutput(op));
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::DiscardAssignment::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_assign;
-      MatchResult result_assign = match_assign.performMatching("$r = SgAssignOp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_assign)
-	{
-	  SgAssignOp* op = (SgAssignOp*)match["$r"];
-	  if (!isSgExprStatement(op->get_parent()))
-	    {
-	      output->addOutput(new CompassAnalyses::DiscardAssignment::CheckerOutput(op));
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::DiscardAssignment::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DiscardAssignment::Traversal(params, output);
   }
 
 extern const Compass::Checker* const discardAssignmentChecker =
@@ -126,5 +150,6 @@ extern const Compass::Checker* const discardAssignmentChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
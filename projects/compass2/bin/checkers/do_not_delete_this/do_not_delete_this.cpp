@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace DoNotDeleteThis
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::DoNotDeleteThis
 #endif // COMPASS_DO_NOT_DELETE_THIS_H
@@ -85,33 +105,41 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::doNotDeleteThisChecker->checkerName,
                           ::doNotDeleteThisChecker->shortDescription) {}
 
+CompassAnalyses::DoNotDeleteThis::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::DoNotDeleteThis::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::DoNotDeleteThis::Traversal::
+visit(SgNode* node)
+  {
+    SgDeleteExp* del = isSgDeleteExp(node);
+    if (del != NULL && isSgThisExp(del->get_variable()) != NULL)
+    {
+        output_->addOutput(new CheckerOutput(del));
+    }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::DoNotDeleteThis::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_del_this;
-      MatchResult result_del_this = match_del_this.performMatching("$r = SgDeleteExp(SgThisExp)", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_del_this)
-	{
-	  SgDeleteExp* del = (SgDeleteExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::DoNotDeleteThis::CheckerOutput(del));
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::DoNotDeleteThis::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
 // Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::DoNotDeleteThis::Traversal(params, output);
   }
 
 extern const Compass::Checker* const doNotDeleteThisChecker =
@@ -123,5 +151,6 @@ extern const Compass::Checker* const doNotDeleteThisChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
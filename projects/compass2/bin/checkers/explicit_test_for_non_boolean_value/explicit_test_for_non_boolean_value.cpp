@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace ExplicitTestForNonBooleanValue
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::ExplicitTestForNonBooleanValue
 #endif // COMPASS_EXPLICIT_TEST_FOR_NON_BOOLEAN_VALUE_H
@@ -85,42 +105,57 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::explicitTestForNonBooleanValueChecker->checkerName,
                           ::explicitTestForNonBooleanValueChecker->shortDescription) {}
 
+CompassAnalyses::ExplicitTestForNonBooleanValue::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::ExplicitTestForNonBooleanValue::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::ExplicitTestForNonBooleanValue::Traversal::
+visit(SgNode* node)
+  {
+    SgStatement* condition = NULL;
+    if (SgIfStmt* if_stmt = isSgIfStmt(node))
+      condition = if_stmt->get_conditional();
+    else if (SgWhileStmt* while_stmt = isSgWhileStmt(node))
+      condition = while_stmt->get_condition();
+    else if (SgDoWhileStmt* do_while_stmt = isSgDoWhileStmt(node))
+      condition = do_while_stmt->get_condition();
+    else if (SgForStatement* for_stmt = isSgForStatement(node))
+      condition = for_stmt->get_test();
+
+    // The condition is a cast to bool, possibly negated.
+    SgExprStatement* test = isSgExprStatement(condition);
+    if (test != NULL)
+      {
+        SgExpression* expr = test->get_expression();
+        if (SgNotOp* not_op = isSgNotOp(expr))
+          expr = not_op->get_operand();
+        if (isSgCastExp(expr) != NULL)
+          {
+            output_->addOutput(new CheckerOutput(node));
+          }
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::ExplicitTestForNonBooleanValue::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_statements;
-      MatchResult result = match_statements.performMatching
-	("$r = SgIfStmt(SgExprStatement(SgCastExp),_,_)\
-        | $r = SgIfStmt(SgExprStatement(SgNotOp(SgCastExp)),_,_)\
-        | $r = SgWhileStmt(SgExprStatement(SgCastExp),_,_)\
-	| $r = SgWhileStmt(SgExprStatement(SgNotOp(SgCastExp)),_,_)\
-        | $r = SgDoWhileStmt(_,SgExprStatement(SgCastExp))\
-        | $r = SgDoWhileStmt(_,SgExprStatement(SgNotOp(SgCastExp)))\
-        | $r = SgForStatement(_,SgExprStatement(SgCastExp),_,_,_)\
-        | $r = SgForStatement(_,SgExprStatement(SgNotOp(SgCastExp)),_,_,_)"\
-	,sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result)
-	{
-	  output->addOutput(new CompassAnalyses::ExplicitTestForNonBooleanValue::CheckerOutput(match["$r"]));
-	}
-      
+    // Use the pre-built ROSE AST
+    CompassAnalyses::ExplicitTestForNonBooleanValue::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::ExplicitTestForNonBooleanValue::Traversal(params, output);
   }
 
 extern const Compass::Checker* const explicitTestForNonBooleanValueChecker =
@@ -132,5 +167,6 @@ extern const Compass::Checker* const explicitTestForNonBooleanValueChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
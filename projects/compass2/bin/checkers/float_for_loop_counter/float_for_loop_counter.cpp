@@ -60,6 +60,27 @@ namespace FloatForLoopCounter
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::FloatForLoopCounter
 #endif // COMPASS_FLOAT_FOR_LOOP_COUNTER_H
@@ -85,52 +106,59 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::floatForLoopCounterChecker->checkerName,
                           ::floatForLoopCounterChecker->shortDescription) {}
 
+CompassAnalyses::FloatForLoopCounter::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::FloatForLoopCounter::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::FloatForLoopCounter::Traversal::
+visit(SgNode* node)
+  {
+    SgForInitStatement* for_root = isSgForInitStatement(node);
+    if (for_root == NULL)
+      return;
+
+    AstMatching var_ref_y_init;
+    MatchResult results = var_ref_y_init.performMatching("$s = SgVarRefExp | $s = SgInitializedName", for_root);
+    BOOST_FOREACH(SingleMatchVarBindings new_match, results)
+      {
+        SgType* t;
+        SgVarRefExp* ref = isSgVarRefExp(new_match["$s"]);
+        if (ref != NULL)
+          {
+            t = ref->get_type();
+          }
+        else
+          {
+            SgInitializedName* init = (SgInitializedName*)new_match["$s"];
+            t = init->get_type();
+          }
+        if (isSgTypeDouble(t) || isSgTypeFloat(t))
+          {
+            output_->addOutput(new CheckerOutput(new_match["$s"]));
+          }
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::FloatForLoopCounter::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_for_init;
-      MatchResult result_for_init = match_for_init.performMatching("$r = SgForInitStatement", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_for_init)
-	{
-	  SgForInitStatement* for_root = (SgForInitStatement*)match["$r"];
-	  AstMatching var_ref_y_init;
-	  MatchResult results = var_ref_y_init.performMatching("$s = SgVarRefExp | $s = SgInitializedName", for_root);
-	  BOOST_FOREACH(SingleMatchVarBindings new_match, results)
-	    {
-	      SgType* t;
-	      SgVarRefExp* ref = isSgVarRefExp(new_match["$s"]);
-	      if (ref != NULL)
-		{
-		  t = ref->get_type();
-		}
-	      else
-		{
-		  SgInitializedName* init = (SgInitializedName*)new_match["$s"];
-		  t = init->get_type();
-		}
-	      if (isSgTypeDouble(t) || isSgTypeFloat(t))
-		{
-		  output->addOutput(new CompassAnalyses::FloatForLoopCounter::CheckerOutput(new_match["$s"]));
-		}
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::FloatForLoopCounter::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::FloatForLoopCounter::Traversal(params, output);
   }
 
 extern const Compass::Checker* const floatForLoopCounterChecker =
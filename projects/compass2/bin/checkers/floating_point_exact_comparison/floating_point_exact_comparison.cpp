@@ -8,7 +8,6 @@
 #include <fstream>
 #include "rose.h"
 #include "string_functions.h"
-#include "AstMatching.h"
 
 #include <boost/foreach.hpp>
 
@@ -65,6 +64,27 @@ namespace CompassAnalyses
       }
     };
 
+    /**
+     * \brief Specification of AST traversal.
+     */
+    class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+     public:
+      Traversal(Compass::Parameters inputParameters,
+                Compass::OutputObject *output);
+
+      void run(SgNode *n)
+        {
+          this->traverse(n, preorder);
+        }
+
+      void visit(SgNode *n);
+
+     private:
+      Compass::OutputObject* output_;
+
+      DISALLOW_COPY_AND_ASSIGN(Traversal);
+    };
+
   } // ::CompassAnalyses
 } // ::FloatingPointExactComparison
 #endif // COMPASS_FLOATING_POINT_EXACT_COMPARISON_H
@@ -113,45 +133,51 @@ CheckerOutput::CheckerOutput(SgNode *const node)
  *  2. For each SgEqualityOp, check if the LHS and RHS are both float types.
  *     If so, activate the checker on the corresponding SgEqualtiyOp
  */
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory = parameters["general::target_directory"].front();
-  CompassAnalyses::FloatingPointExactComparison::source_directory.assign(
-      target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-  // Search for all SgEqualityOps
-  AstMatching equality_matcher;
-  MatchResult equality_matches = equality_matcher
-      .performMatching("$r = SgEqualityOp", root_node);
-
-  // for each SgEqualityOp check if the LHS and RHS are both float types
-  BOOST_FOREACH(SingleMatchVarBindings matched_equality, equality_matches)
+CompassAnalyses::FloatingPointExactComparison::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::FloatingPointExactComparison::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::FloatingPointExactComparison::Traversal::
+visit(SgNode* node)
   {
-    SgEqualityOp *comparison = (SgEqualityOp *)matched_equality["$r"];
-    if(comparison->get_lhs_operand_i() == NULL ||
+    SgEqualityOp *comparison = isSgEqualityOp(node);
+    if(comparison == NULL ||
+        comparison->get_lhs_operand_i() == NULL ||
         comparison->get_lhs_operand_i()->get_type() == NULL ||
         comparison->get_rhs_operand_i() == NULL ||
         comparison->get_rhs_operand_i()->get_type() == NULL)
     {
-      continue;  // skip if we can't do our comparison
+      return;  // skip if we can't do our comparison
     }
     //                                       (could change to && for less strict)
     if(comparison->get_lhs_operand_i()->get_type()->isFloatType() || // ^
         comparison->get_rhs_operand_i()->get_type()->isFloatType())
     {
-      output->addOutput(
-          new CompassAnalyses::FloatingPointExactComparison::
-          CheckerOutput(comparison));
+      output_->addOutput(new CheckerOutput(comparison));
     }
   }
-}
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+    // Use the pre-built ROSE AST
+    CompassAnalyses::FloatingPointExactComparison::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
+  }
+
+static Compass::AstSimpleProcessingWithRunFunction*
+createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+  {
+    return new CompassAnalyses::FloatingPointExactComparison::Traversal(params, output);
+  }
 
 extern const Compass::Checker* const floatingPointExactComparisonChecker =
     new Compass::CheckerUsingAstSimpleProcessing(
@@ -162,5 +188,5 @@ extern const Compass::Checker* const floatingPointExactComparisonChecker =
         Compass::C | Compass::Cpp,
         Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
         run,
-        NULL);
+        createTraversal);
 
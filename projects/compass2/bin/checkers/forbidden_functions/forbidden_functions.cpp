@@ -9,7 +9,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -61,6 +60,28 @@ namespace ForbiddenFunctions
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+    std::map<string, string> blacklist_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::ForbiddenFunctions
 #endif // COMPASS_FORBIDDEN_FUNCTIONS_H
@@ -86,48 +107,54 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::forbiddenFunctionsChecker->checkerName,
                           ::forbiddenFunctionsChecker->shortDescription) {}
 
+CompassAnalyses::ForbiddenFunctions::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::ForbiddenFunctions::source_directory.assign(target_directory);
+
+    Compass::ParametersMap forbidden = parameters[boost::regex("forbiddenFunctions::.*$")];
+    BOOST_FOREACH(const Compass::ParametersMap::value_type& pair, forbidden)
+      {
+        Compass::ParameterValues values = pair.second;
+        BOOST_FOREACH(string func, values)
+          {
+            blacklist_[func] = func;
+          }
+      }
+  }
+
+void
+CompassAnalyses::ForbiddenFunctions::Traversal::
+visit(SgNode* node)
+  {
+    SgFunctionRefExp* reference = isSgFunctionRefExp(node);
+    if (reference != NULL)
+      {
+        string function_name = reference->get_symbol()->get_name().getString();
+        if (blacklist_.find(function_name) != blacklist_.end())
+          {
+            output_->addOutput(new CheckerOutput(reference));
+          }
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-    std::map<string, string> blacklist;
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::ForbiddenFunctions::source_directory.assign(target_directory);
-      
-      Compass::ParametersMap forbidden = parameters[boost::regex("forbiddenFunctions::.*$")];
-      BOOST_FOREACH(const Compass::ParametersMap::value_type& pair, forbidden)
-	{
-	  Compass::ParameterValues values = pair.second;
-	  BOOST_FOREACH(string func, values)
-	    {
-	      blacklist[func] = func;
-	    }
-	}
-
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_func_ref;
-      MatchResult res_function_refs = match_func_ref.performMatching("$r = SgFunctionRefExp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, res_function_refs)
-	{
-	  SgFunctionRefExp* reference = (SgFunctionRefExp*)match["$r"];
-	  string function_name = reference->get_symbol()->get_name().getString();
-	  if(blacklist[function_name] == function_name)
-	    {
-	      output->addOutput(new CompassAnalyses::ForbiddenFunctions::CheckerOutput(reference));
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::ForbiddenFunctions::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::ForbiddenFunctions::Traversal(params, output);
   }
 
 extern const Compass::Checker* const forbiddenFunctionsChecker =
@@ -139,5 +166,6 @@ extern const Compass::Checker* const forbiddenFunctionsChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
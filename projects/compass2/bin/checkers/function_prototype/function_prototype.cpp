@@ -10,7 +10,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -62,6 +61,31 @@ namespace FunctionPrototype
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+    void atTraversalEnd();
+
+   private:
+    Compass::OutputObject* output_;
+    std::vector<SgFunctionDeclaration*> declarations_;
+    std::map<string, bool> has_prototype_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::FunctionPrototype
 #endif // COMPASS_FUNCTION_PROTOTYPE_H
@@ -87,55 +111,62 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::functionPrototypeChecker->checkerName,
                           ::functionPrototypeChecker->shortDescription) {}
 
+CompassAnalyses::FunctionPrototype::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::FunctionPrototype::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::FunctionPrototype::Traversal::
+visit(SgNode* node)
+  {
+    // Derived declarations, such as member functions, are not checked.
+    if (node->variantT() != V_SgFunctionDeclaration)
+      return;
+
+    // A function has a prototype if any of its declarations is a forward
+    // declaration, which may come after the declarations that need it, so
+    // violations are reported once the whole AST has been seen.
+    SgFunctionDeclaration* function_decl = isSgFunctionDeclaration(node);
+    declarations_.push_back(function_decl);
+    bool& has_prototype = has_prototype_[function_decl->get_name().getString()];
+    if (function_decl->isForward())
+      has_prototype = true;
+  }
+
+void
+CompassAnalyses::FunctionPrototype::Traversal::
+atTraversalEnd()
+  {
+    BOOST_FOREACH(SgFunctionDeclaration* function_decl, declarations_)
+      {
+        if (has_prototype_[function_decl->get_name().getString()] == false)
+          {
+            output_->addOutput(new CheckerOutput(function_decl));
+          }
+      }
+    declarations_.clear();
+    has_prototype_.clear();
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::FunctionPrototype::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_func_decl;
-      MatchResult result_func_decl = match_func_decl.performMatching
-	("$r = SgFunctionDeclaration", sageProject);
-      std::map<string, bool> has_prototype;
-
-      BOOST_FOREACH(SingleMatchVarBindings match, result_func_decl)
-	{
-	  SgFunctionDeclaration* function_decl = (SgFunctionDeclaration*)match["$r"];
-	  string function_name = function_decl->get_name().getString();
-	  has_prototype[function_name] = false;
-	}
-      BOOST_FOREACH(SingleMatchVarBindings match, result_func_decl)
-	{
-	  SgFunctionDeclaration* function_decl = (SgFunctionDeclaration*)match["$r"];
-	  string function_name = function_decl->get_name().getString();
-	  if (function_decl->isForward())
-	    {
-	      has_prototype[function_name] = true;
-	    }
-	}
-      BOOST_FOREACH(SingleMatchVarBindings match, result_func_decl)
-	{
-	  SgFunctionDeclaration* function_decl = (SgFunctionDeclaration*)match["$r"];
-	  string function_name = function_decl->get_name().getString();
-	  if (has_prototype[function_name] == false)
-	    {
-	      output->addOutput(new CompassAnalyses::FunctionPrototype::CheckerOutput(function_decl));
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::FunctionPrototype::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::FunctionPrototype::Traversal(params, output);
   }
 
 extern const Compass::Checker* const functionPrototypeChecker =
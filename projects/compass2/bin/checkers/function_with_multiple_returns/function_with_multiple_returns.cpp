@@ -65,6 +65,28 @@ namespace CompassAnalyses
       }
     };
 
+    /**
+     * \brief Specification of AST traversal.
+     */
+    class Traversal : public Compass::AstSimpleProcessingWithRunFunction
+    {
+     public:
+      Traversal(Compass::Parameters inputParameters,
+                Compass::OutputObject *output);
+
+      void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+      void visit(SgNode *n);
+
+     private:
+      Compass::OutputObject* output_;
+
+      DISALLOW_COPY_AND_ASSIGN(Traversal);
+    };
+
   }  // ::CompassAnalyses
 }  // ::FunctionWithMultipleReturns
 #endif // COMPASS_FUNCTION_WITH_MULTIPLE_RETURNS_H
@@ -93,7 +115,7 @@ CompassAnalyses::FunctionWithMultipleReturns::CheckerOutput::CheckerOutput(
 
 // Checker main run function and metadata
 
-/** run(Compass::Parameters parameters, Compass::OutputObject* output)
+/** Traversal::visit(SgNode* node)
  *
  *  Purpose
  *  ========
@@ -111,56 +133,57 @@ CompassAnalyses::FunctionWithMultipleReturns::CheckerOutput::CheckerOutput(
  *  Algorithm
  *  ==========
  *
- *  1. Search for all SgFunctionDeclarations
+ *  1. Visit each SgFunctionDefinition
  *
- *  2. For each SgFunctionDeclaration, search for child nodes that
+ *  2. For each SgFunctionDefinition, search for child nodes that
  *     are SgReturnStmt's
  */
-static void run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::FunctionWithMultipleReturns::Traversal::Traversal(
+    Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
 {
   // We only care about source code in the user's space, not,
   // for example, Boost or system files.
   std::string target_directory = parameters["general::target_directory"].front();
   CompassAnalyses::FunctionWithMultipleReturns::source_directory.assign(
       target_directory);
+}
 
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-  // 1. Search for all SgFunctionDeclarations
-  AstMatching function_matcher;
-  MatchResult function_matches = function_matcher
-      .performMatching("$r = SgFunctionDefinition", root_node);
-
-  // 2. Check if there are multiple SgReturnStmt's for this SgFunctionDefinition
-  BOOST_FOREACH(SingleMatchVarBindings matched_function, function_matches)
+void CompassAnalyses::FunctionWithMultipleReturns::Traversal::visit(SgNode* node)
+{
+  // 1. Derived definitions, such as those of template instantiations,
+  //    are not checked
+  if (node->variantT() != V_SgFunctionDefinition)
   {
-    SgNode* function = matched_function["$r"];
-
-    AstMatching return_matcher;
-    MatchResult return_matches = return_matcher
-        .performMatching("$r = SgReturnStmt", function);
-
-    int num_matches = return_matches.size();
+    return;
+  }
 
-    if(num_matches > 1)
-    {
-      output->addOutput(
-          new CompassAnalyses::FunctionWithMultipleReturns::
-          CheckerOutput(function));
+  // 2. Check if there are multiple SgReturnStmt's for this SgFunctionDefinition
+  AstMatching return_matcher;
+  MatchResult return_matches = return_matcher
+      .performMatching("$r = SgReturnStmt", node);
 
-      // verbose output
-      /*
-      if (SgProject::get_verbose > 0)
-      {
-        std::cout << "num_returns: " << num_matches << std::endl;
-      }*/
-    }
+  int num_matches = return_matches.size();
 
+  if(num_matches > 1)
+  {
+    output_->addOutput(new CheckerOutput(node));
   }
 }
 
+static void run(Compass::Parameters parameters, Compass::OutputObject* output)
+{
+  // Use the pre-built ROSE AST
+  CompassAnalyses::FunctionWithMultipleReturns::Traversal(parameters, output)
+      .run(Compass::projectPrerequisite.getProject());
+}
+
+static Compass::AstSimpleProcessingWithRunFunction*
+createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+{
+  return new CompassAnalyses::FunctionWithMultipleReturns::Traversal(
+      params, output);
+}
 
 extern const Compass::Checker* const functionWithMultipleReturnsChecker =
     new Compass::CheckerUsingAstSimpleProcessing(
@@ -170,4 +193,4 @@ extern const Compass::Checker* const functionWithMultipleReturnsChecker =
         CompassAnalyses::FunctionWithMultipleReturns::long_description,
         Compass::C | Compass::Cpp,
         Compass::PrerequisiteList(1, &Compass::projectPrerequisite), run,
-        NULL);
+        createTraversal);
@@ -11,7 +11,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -63,6 +62,28 @@ namespace MagicNumber
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+    std::map<string, string> magic_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::MagicNumber
 #endif // COMPASS_MAGIC_NUMBER_H
@@ -88,60 +109,64 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::magicNumberChecker->checkerName,
                           ::magicNumberChecker->shortDescription) {}
 
+CompassAnalyses::MagicNumber::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::MagicNumber::source_directory.assign(target_directory);
+
+    Compass::ParametersMap things = parameters[boost::regex("^magicNumbers::.*$")];
+    BOOST_FOREACH(const Compass::ParametersMap::value_type& pair, things)
+      {
+        Compass::ParameterValues values = pair.second;
+        BOOST_FOREACH(string keyword, values)
+          {
+            magic_[keyword] = keyword;
+          }
+      }
+  }
+
+void
+CompassAnalyses::MagicNumber::Traversal::
+visit(SgNode* node)
+  {
+    SgValueExp* val = NULL;
+    if (isSgIntVal(node) != NULL || isSgDoubleVal(node) != NULL)
+      val = isSgValueExp(node);
+    if (val != NULL && val->get_originalExpressionTree() == NULL)
+      {
+        SgNode* p = val->get_parent();
+        while (isSgExpression(p) && !isSgInitializer(p))
+          {
+            p = p->get_parent();
+          }
+        if (!isSgInitializer(p) || isSgConstructorInitializer(p))
+          {
+            string number = val->get_constant_folded_value_as_string();
+            if (magic_.find(number) == magic_.end())
+              {
+                output_->addOutput(new CheckerOutput(val));
+              }
+          }
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-    typedef std::map<string, string> ExpectedValuesMap;
-    ExpectedValuesMap magic_;
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::MagicNumber::source_directory.assign(target_directory);
-
-      Compass::ParametersMap things = parameters[boost::regex("^magicNumbers::.*$")];
-      BOOST_FOREACH(const Compass::ParametersMap::value_type& pair, things)
-	{
-	  Compass::ParameterValues values = pair.second;
-	  BOOST_FOREACH(string keyword, values)
-	    {
-	      magic_[keyword] = keyword;
-	    }
-	}
-
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_val_exps;
-      MatchResult val_exps_result = match_val_exps.performMatching("$r = SgIntVal | $r = SgDoubleVal", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, val_exps_result)
-	{
-	  SgValueExp* val = (SgValueExp*)match["$r"];
-	  if (val->get_originalExpressionTree() == NULL)
-	    {
-	      SgNode* p = val->get_parent();
-	      while (isSgExpression(p) && !isSgInitializer(p))
-		{
-		  p = p->get_parent();
-		}
-	      if (!isSgInitializer(p) || isSgConstructorInitializer(p))
-		{
-		  string number = val->get_constant_folded_value_as_string();
-		  if (magic_[number] == "")
-		    {
-		      output->addOutput(new CompassAnalyses::MagicNumber::CheckerOutput(val));
-		    }
-		}
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::MagicNumber::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::MagicNumber::Traversal(params, output);
   }
 
 extern const Compass::Checker* const magicNumberChecker =
@@ -153,5 +178,6 @@ extern const Compass::Checker* const magicNumberChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
@@ -7,7 +7,6 @@
 #include "rose.h"
 #include "compass2/compass.h"
 #include <boost/foreach.hpp>
-#include "AstMatching.h"
 
 
 using std::string;
@@ -57,6 +56,27 @@ bool IsNodeNotInUserLocation(const SgNode* node)
   }
 };
 
+/**
+ * \brief Specification of AST traversal.
+ */
+class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+ public:
+  Traversal(Compass::Parameters inputParameters,
+            Compass::OutputObject *output);
+
+  void run(SgNode *n)
+    {
+      this->traverse(n, preorder);
+    }
+
+  void visit(SgNode *n);
+
+ private:
+  Compass::OutputObject* output_;
+
+  DISALLOW_COPY_AND_ASSIGN(Traversal);
+};
+
 } // ::CompassAnalyses
 } // ::NoGoto
 #endif // COMPASS_NO_GOTO_H
@@ -82,35 +102,41 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                       ::noGotoChecker->checkerName,
                        ::noGotoChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory =
-      parameters["general::target_directory"].front();
-  CompassAnalyses::NoGoto::source_directory.assign(target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-
+CompassAnalyses::NoGoto::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::NoGoto::source_directory.assign(target_directory);
+  }
 
-  // search for SgGotoStatements
-  AstMatching matcher;
-  MatchResult matches = matcher
-      .performMatching("$r = SgGotoStatement", root_node);
+void
+CompassAnalyses::NoGoto::Traversal::
+visit(SgNode* node)
+  {
+    SgGotoStatement* goto_statement = isSgGotoStatement(node);
+    if (goto_statement != NULL)
+    {
+        output_->addOutput(new CheckerOutput(goto_statement));
+    }
+  }
 
-  BOOST_FOREACH(SingleMatchVarBindings match, matches)
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-    SgGotoStatement *goto_statement = (SgGotoStatement *)match["$r"];
-    output->addOutput(
-        new CompassAnalyses::NoGoto::
-        CheckerOutput(goto_statement));
+    // Use the pre-built ROSE AST
+    CompassAnalyses::NoGoto::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-}
+static Compass::AstSimpleProcessingWithRunFunction*
+createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+  {
+    return new CompassAnalyses::NoGoto::Traversal(params, output);
+  }
 
 extern const Compass::Checker* const noGotoChecker =
     new Compass::CheckerUsingAstSimpleProcessing(
@@ -121,5 +147,6 @@ extern const Compass::Checker* const noGotoChecker =
         Compass::C | Compass::Cpp,
         Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
         run,
-        NULL);
+        createTraversal,
+        true /*threadSafe*/);
 
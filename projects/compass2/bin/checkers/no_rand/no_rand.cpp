@@ -6,7 +6,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -58,6 +57,27 @@ namespace CompassAnalyses
       }
     };
 
+    /**
+     * \brief Specification of AST traversal.
+     */
+    class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+     public:
+      Traversal(Compass::Parameters inputParameters,
+                Compass::OutputObject *output);
+
+      void run(SgNode *n)
+        {
+          this->traverse(n, preorder);
+        }
+
+      void visit(SgNode *n);
+
+     private:
+      Compass::OutputObject* output_;
+
+      DISALLOW_COPY_AND_ASSIGN(Traversal);
+    };
+
   } // ::CompassAnalyses
 } // ::NoRand
 #endif // COMPASS_NO_RAND_H
@@ -83,38 +103,45 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                       ::noRandChecker->checkerName,
                        ::noRandChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory =
-      parameters["general::target_directory"].front();
-  CompassAnalyses::NoRand::source_directory.assign(target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-  SgNode* root_node = (SgNode*) sageProject;
-
-  // perform AST matching
-  AstMatching matcher;
-
-  MatchResult matches = matcher.performMatching("$r=SgFunctionRefExp",
-                                                root_node);
-
-  BOOST_FOREACH(SingleMatchVarBindings match, matches)
+CompassAnalyses::NoRand::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
   {
-    SgFunctionRefExp *function = (SgFunctionRefExp *)match["$r"];
-    std::string fncName = function->get_symbol()->get_name().getString();
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::NoRand::source_directory.assign(target_directory);
+  }
 
-    if( fncName.find( "rand", 0, 4) != std::string::npos)
+void
+CompassAnalyses::NoRand::Traversal::
+visit(SgNode* node)
+  {
+    SgFunctionRefExp* function = isSgFunctionRefExp(node);
+    if (function != NULL)
     {
-      output->addOutput(
-          new CompassAnalyses::NoRand::CheckerOutput(function));
+        std::string fncName = function->get_symbol()->get_name().getString();
+        if (fncName.find("rand", 0, 4) != std::string::npos)
+        {
+            output_->addOutput(new CheckerOutput(function));
+        }
     }
   }
-}
 
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+    // Use the pre-built ROSE AST
+    CompassAnalyses::NoRand::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
+  }
+
+static Compass::AstSimpleProcessingWithRunFunction*
+createTraversal(Compass::Parameters params, Compass::OutputObject* output)
+  {
+    return new CompassAnalyses::NoRand::Traversal(params, output);
+  }
 
 extern const Compass::Checker* const noRandChecker =
     new Compass::CheckerUsingAstSimpleProcessing(
@@ -125,5 +152,6 @@ extern const Compass::Checker* const noRandChecker =
         Compass::C | Compass::Cpp,
         Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
         run,
-        NULL);
+        createTraversal,
+        true /*threadSafe*/);
 
@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ bool IsNodeNotInUserLocation(const SgNode* node)
   }
 };
 
+/**
+ * \brief Specification of AST traversal.
+ */
+class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+ public:
+  Traversal(Compass::Parameters inputParameters,
+            Compass::OutputObject *output);
+
+  void run(SgNode *n)
+    {
+      this->traverse(n, preorder);
+    }
+
+  void visit(SgNode *n);
+
+ private:
+  Compass::OutputObject* output_;
+
+  DISALLOW_COPY_AND_ASSIGN(Traversal);
+};
+
 } // ::CompassAnalyses
 } // ::NoVariadicFunctions
 #endif // COMPASS_NO_VARIADIC_FUNCTIONS_H
@@ -89,26 +109,26 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                       ::noVariadicFunctionsChecker->checkerName,
                        ::noVariadicFunctionsChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
-{
-  // We only care about source code in the user's space, not,
-  // for example, Boost or system files.
-  string target_directory =
-      parameters["general::target_directory"].front();
-  CompassAnalyses::NoVariadicFunctions::source_directory.assign(target_directory);
-
-  // Use the pre-built ROSE AST
-  SgProject* sageProject = Compass::projectPrerequisite.getProject();
-
-  SgNode *root_node = (SgNode *)sageProject;
+CompassAnalyses::NoVariadicFunctions::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::NoVariadicFunctions::source_directory.assign(target_directory);
+  }
 
-  AstMatching func_dec_matcher;
-  MatchResult func_dec_matches = func_dec_matcher
-      .performMatching("$f=SgFunctionDeclaration", root_node);
-  BOOST_FOREACH(SingleMatchVarBindings func_dec_match, func_dec_matches)
+void
+CompassAnalyses::NoVariadicFunctions::Traversal::
+visit(SgNode* node)
   {
-    SgFunctionDeclaration *func_dec = (SgFunctionDeclaration *)func_dec_match["$f"];
+    // Derived declarations, such as member functions, are not checked.
+    if (node->variantT() != V_SgFunctionDeclaration)
+      return;
+
+    SgFunctionDeclaration *func_dec = isSgFunctionDeclaration(node);
     SgFunctionParameterList *func_params = func_dec->get_parameterList();
     for(int i = 0; i < func_params->get_numberOfTraversalSuccessors(); i++)
     {
@@ -117,22 +137,24 @@ run(Compass::Parameters parameters, Compass::OutputObject* output)
       if(isSgTypeEllipse(func_param->get_type()) != NULL)
       {
         // then this is a variadic function
-        output->addOutput(
-            new CompassAnalyses::NoVariadicFunctions::
-            CheckerOutput(func_dec));
+        output_->addOutput(new CheckerOutput(func_dec));
       }
     }
   }
 
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+    // Use the pre-built ROSE AST
+    CompassAnalyses::NoVariadicFunctions::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
+  }
 
-}
-
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
-{
-  return NULL;
-}
+  {
+    return new CompassAnalyses::NoVariadicFunctions::Traversal(params, output);
+  }
 
 extern const Compass::Checker* const noVariadicFunctionsChecker =
     new Compass::CheckerUsingAstSimpleProcessing(
@@ -143,5 +165,6 @@ extern const Compass::Checker* const noVariadicFunctionsChecker =
         Compass::C | Compass::Cpp,
         Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
         run,
-        createTraversal);
+        createTraversal,
+        true /*threadSafe*/);
 
@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -63,6 +62,27 @@ namespace NoVfork
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::NoVfork
 #endif // COMPASS_NO_VFORK_H
@@ -88,42 +108,45 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::noVforkChecker->checkerName,
                           ::noVforkChecker->shortDescription) {}
 
-static void
-run(Compass::Parameters parameters, Compass::OutputObject* output)
+CompassAnalyses::NoVfork::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::NoVfork::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      SgNode *root_node = (SgNode*)sageProject;
-
-      AstMatching func_ref_matcher;
-      MatchResult func_ref_matches = func_ref_matcher
-          .performMatching("$f=SgFunctionRefExp", root_node);
-      BOOST_FOREACH(SingleMatchVarBindings match, func_ref_matches)
-      {
-        SgFunctionRefExp *func_ref = (SgFunctionRefExp *)match["$f"];
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::NoVfork::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::NoVfork::Traversal::
+visit(SgNode* node)
+  {
+    SgFunctionRefExp* func_ref = isSgFunctionRefExp(node);
+    if (func_ref != NULL)
+    {
         std::string func_str = func_ref->get_symbol()->get_name().getString();
-        if(func_str.compare("vfork") == 0)
+        if (func_str.compare("vfork") == 0)
         {
-          output->addOutput(
-              new CompassAnalyses::NoVfork::
-              CheckerOutput(func_ref));
+            output_->addOutput(new CheckerOutput(func_ref));
         }
-      }
-      
+    }
+  }
+
+static void
+run(Compass::Parameters parameters, Compass::OutputObject* output)
+  {
+    // Use the pre-built ROSE AST
+    CompassAnalyses::NoVfork::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
 // Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::NoVfork::Traversal(params, output);
   }
 
 extern const Compass::Checker* const noVforkChecker =
@@ -135,5 +158,6 @@ extern const Compass::Checker* const noVforkChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace PointerComparison
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::PointerComparison
 #endif // COMPASS_POINTER_COMPARISON_H
@@ -85,44 +105,47 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::pointerComparisonChecker->checkerName,
                           ::pointerComparisonChecker->shortDescription) {}
 
+CompassAnalyses::PointerComparison::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::PointerComparison::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::PointerComparison::Traversal::
+visit(SgNode* node)
+  {
+    if (isSgGreaterThanOp(node) || isSgGreaterOrEqualOp(node) ||
+        isSgLessThanOp(node) || isSgLessOrEqualOp(node))
+      {
+        SgBinaryOp* op = isSgBinaryOp(node);
+        SgType *lhs, *rhs;
+        lhs = op->get_lhs_operand()->get_type();
+        rhs = op->get_rhs_operand()->get_type();
+        if (isSgPointerType(lhs) || isSgPointerType(rhs))
+          {
+            output_->addOutput(new CheckerOutput(op));
+          }
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::PointerComparison::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching matchop;
-      MatchResult result = matchop.performMatching
-	("$r = SgGreaterThanOp\
-        | $r = SgGreaterOrEqualOp\
-        | $r = SgLessThanOp\
-        | $r = SgLessOrEqualOp"
-	, sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result)
-	{
-	  SgBinaryOp* op = (SgBinaryOp*)match["$r"];
-	  SgType *lhs, *rhs;
-	  lhs = op->get_lhs_operand()->get_type();
-	  rhs = op->get_rhs_operand()->get_type();
-	  if (isSgPointerType(lhs) || isSgPointerType(rhs))
-	    {
-	      output->addOutput(new CompassAnalyses::PointerComparison::CheckerOutput(op));
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::PointerComparison::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::PointerComparison::Traversal(params, output);
   }
 
 extern const Compass::Checker* const pointerComparisonChecker =
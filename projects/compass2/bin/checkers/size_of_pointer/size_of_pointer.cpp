@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace SizeOfPointer
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::SizeOfPointer
 #endif // COMPASS_SIZE_OF_POINTER_H
@@ -85,34 +105,42 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::sizeOfPointerChecker->checkerName,
                           ::sizeOfPointerChecker->shortDescription) {}
 
+CompassAnalyses::SizeOfPointer::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::SizeOfPointer::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::SizeOfPointer::Traversal::
+visit(SgNode* node)
+  {
+    SgSizeOfOp* size_of = isSgSizeOfOp(node);
+    if (size_of != NULL)
+      {
+        SgVarRefExp* var_ref = isSgVarRefExp(size_of->get_operand_expr());
+        if (var_ref != NULL && isSgPointerType(var_ref->get_type()))
+          output_->addOutput(new CheckerOutput(var_ref));
+      }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::SizeOfPointer::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_sizeof;
-      MatchResult result_sizeof = match_sizeof.performMatching("SgSizeOfOp($r=SgVarRefExp)", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_sizeof)
-	{
-	  SgVarRefExp* var_ref = (SgVarRefExp*)match["$r"];
-	  if(isSgPointerType(var_ref->get_type()))
-	    output->addOutput(new CompassAnalyses::SizeOfPointer::CheckerOutput(var_ref));
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::SizeOfPointer::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
-// Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::SizeOfPointer::Traversal(params, output);
   }
 
 extern const Compass::Checker* const sizeOfPointerChecker =
@@ -124,5 +152,6 @@ extern const Compass::Checker* const sizeOfPointerChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace TernaryOperator
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::TernaryOperator
 #endif // COMPASS_TERNARY_OPERATOR_H
@@ -85,33 +105,41 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::ternaryOperatorChecker->checkerName,
                           ::ternaryOperatorChecker->shortDescription) {}
 
+CompassAnalyses::TernaryOperator::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::TernaryOperator::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::TernaryOperator::Traversal::
+visit(SgNode* node)
+  {
+    SgConditionalExp* tri = isSgConditionalExp(node);
+    if (tri != NULL)
+    {
+        output_->addOutput(new CheckerOutput(tri));
+    }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::TernaryOperator::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_ternary;
-      MatchResult result_ternary = match_ternary.performMatching("$r = SgConditionalExp", sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_ternary)
-	{
-	  SgConditionalExp* tri = (SgConditionalExp*)match["$r"];
-	  output->addOutput(new CompassAnalyses::TernaryOperator::CheckerOutput(tri));
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::TernaryOperator::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
 // Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::TernaryOperator::Traversal(params, output);
   }
 
 extern const Compass::Checker* const ternaryOperatorChecker =
@@ -123,5 +151,6 @@ extern const Compass::Checker* const ternaryOperatorChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
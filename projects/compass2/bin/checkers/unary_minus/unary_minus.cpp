@@ -8,7 +8,6 @@
 
 #include "rose.h"
 #include "compass2/compass.h"
-#include "AstMatching.h"
 
 using std::string;
 using namespace StringUtility;
@@ -60,6 +59,27 @@ namespace UnaryMinus
       }
   };
 
+  /**
+   * \brief Specification of AST traversal.
+   */
+  class Traversal : public Compass::AstSimpleProcessingWithRunFunction {
+   public:
+    Traversal(Compass::Parameters inputParameters,
+              Compass::OutputObject *output);
+
+    void run(SgNode *n)
+      {
+        this->traverse(n, preorder);
+      }
+
+    void visit(SgNode *n);
+
+   private:
+    Compass::OutputObject* output_;
+
+    DISALLOW_COPY_AND_ASSIGN(Traversal);
+  };
+
 } // ::CompassAnalyses
 } // ::UnaryMinus
 #endif // COMPASS_UNARY_MINUS_H
@@ -85,39 +105,52 @@ CheckerOutput::CheckerOutput(SgNode *const node)
                           ::unaryMinusChecker->checkerName,
                           ::unaryMinusChecker->shortDescription) {}
 
+CompassAnalyses::UnaryMinus::
+Traversal::Traversal(Compass::Parameters parameters, Compass::OutputObject* output)
+    : output_(output)
+  {
+    // We only care about source code in the user's space, not,
+    // for example, Boost or system files.
+    string target_directory =
+        parameters["general::target_directory"].front();
+    CompassAnalyses::UnaryMinus::source_directory.assign(target_directory);
+  }
+
+void
+CompassAnalyses::UnaryMinus::Traversal::
+visit(SgNode* node)
+  {
+    // Matches -x and -(T)x where x is a variable of unsigned type.
+    SgMinusOp* minus = isSgMinusOp(node);
+    if (minus == NULL)
+    {
+        return;
+    }
+    SgExpression* operand = minus->get_operand();
+    if (isSgCastExp(operand) != NULL)
+    {
+        operand = isSgCastExp(operand)->get_operand();
+    }
+    SgVarRefExp* var = isSgVarRefExp(operand);
+    if (var != NULL && var->get_type()->isUnsignedType())
+    {
+        output_->addOutput(new CheckerOutput(var));
+    }
+  }
+
 static void
 run(Compass::Parameters parameters, Compass::OutputObject* output)
   {
-      // We only care about source code in the user's space, not,
-      // for example, Boost or system files.
-      string target_directory =
-          parameters["general::target_directory"].front();
-      CompassAnalyses::UnaryMinus::source_directory.assign(target_directory);
-      
-      // Use the pre-built ROSE AST
-      SgProject* sageProject = Compass::projectPrerequisite.getProject();
-      
-      // perform AST matching here
-      AstMatching match_var;
-      MatchResult result_var = match_var.performMatching
-	("SgMinusOp($r=SgVarRefExp)\
-        | SgMinusOp(SgCastExp($r=SgVarRefExp))"\
-        , sageProject);
-      BOOST_FOREACH(SingleMatchVarBindings match, result_var)
-	{
-	  SgVarRefExp* var = (SgVarRefExp*)match["$r"];
-	  if (var->get_type()->isUnsignedType())
-	    {
-	      output->addOutput(new CompassAnalyses::UnaryMinus::CheckerOutput(var));
-	    }
-	}
+    // Use the pre-built ROSE AST
+    CompassAnalyses::UnaryMinus::Traversal(parameters, output).run(
+      Compass::projectPrerequisite.getProject());
   }
 
 // Remove this function if your checker is not an AST traversal
 static Compass::AstSimpleProcessingWithRunFunction*
 createTraversal(Compass::Parameters params, Compass::OutputObject* output)
   {
-    return NULL;
+    return new CompassAnalyses::UnaryMinus::Traversal(params, output);
   }
 
 extern const Compass::Checker* const unaryMinusChecker =
@@ -129,5 +162,6 @@ extern const Compass::Checker* const unaryMinusChecker =
       Compass::C | Compass::Cpp,
       Compass::PrerequisiteList(1, &Compass::projectPrerequisite),
       run,
-      createTraversal);
+      createTraversal,
+      true /*threadSafe*/);
 
@@ -65,6 +65,49 @@ void build_checkers (std::vector<const Compass::Checker*> & checkers, Compass::P
     Compass::OutputObject & output, SgProject* pr)
   {}
 
+/**
+  * \returns true if the general parameter \a name is set to "true", "yes", or
+  * "1".  Missing parameters are false.
+  */
+static bool IsOptionEnabled (const Compass::Parameters& params, const std::string& name)
+  {
+    try
+    {
+        std::string value = boost::trim_copy (params.get_unique (name));
+        return "true" == value || "yes" == value || "1" == value;
+    }
+    catch (const Compass::ParameterException&)
+    {
+        return false;
+    }
+  }
+
+/**
+  * \returns the value of the general parameter "threads", the number of
+  * threads used for thread-safe checkers.  Zero means one per hardware
+  * thread; a missing or invalid value means one.
+  */
+static size_t GetThreadsOption (const Compass::Parameters& params)
+  {
+    try
+    {
+        std::string value = boost::trim_copy (params.get_unique ("general::threads"));
+        return boost::lexical_cast<size_t> (value);
+    }
+    catch (const Compass::ParameterException&)
+    {
+        return 1;
+    }
+    catch (const boost::bad_lexical_cast&)
+    {
+        std::cerr
+          << "[Compass] [Parameters] "
+          << "Invalid value for general::threads; using one thread"
+          << std::endl;
+        return 1;
+    }
+  }
+
 /**
   * \todo document
   */
@@ -234,7 +277,17 @@ int main (int argc, char** argv)
     //  Run Compass Analyses
     // -------------------------------------------------------------------------
 
-    std::vector<std::pair<std::string, std::string> > errors;
+    const bool fused_traversal = IsOptionEnabled (params, "general::fused_traversal");
+    const bool print_timing = IsOptionEnabled (params, "general::print_timing");
+    const size_t threads = GetThreadsOption (params);
+
+    // Thread-safe checkers that provide an AST traversal run file by file on
+    // several threads when more than one thread is requested.  Of the rest,
+    // checkers that provide an AST traversal share a single walk over the AST
+    // when fused_traversal is enabled; all other checkers run on their own.
+    Compass::ParallelCheckerTraversal parallel (threads, print_timing);
+    Compass::CombinedCheckerTraversal combined (print_timing);
+    std::vector<const Compass::Checker*> standalone;
     for (std::vector<const Compass::Checker*>::iterator itr = traversals.begin();
          itr != traversals.end();
          ++itr)
@@ -247,48 +300,168 @@ int main (int argc, char** argv)
               << std::endl;
             return 1;
         }
-        else
+        if (threads != 1 && parallel.addChecker (*itr, params))
+        {
+            continue;
+        }
+        if (!fused_traversal || !combined.addChecker (*itr, params, &output))
         {
+            standalone.push_back (*itr);
+        }
+    }
 
-            if (SgProject::get_verbose () >= 0)
+    std::vector<std::pair<std::string, std::string> > errors;
+    std::vector<std::pair<std::string, double> > timings;
+
+    if (parallel.size () > 0)
+    {
+        if (SgProject::get_verbose () >= 0)
+        {
+            for (size_t i = 0; i < parallel.size (); ++i)
+            {
+                std::cout
+                  << "[Compass] [Main] "
+                  << "Running checker "
+                  << parallel.getChecker (i)->checkerName.c_str ()
+                  << " (parallel)"
+                  << std::endl;
+            }
+        }
+
+        // ---------------------------------------------------------------------
+        //  !! PERFORM PARALLEL TRAVERSAL !!
+        // ---------------------------------------------------------------------
+        double start = Compass::wallClockSeconds ();
+        parallel.run (project, &output);
+        double elapsed = Compass::wallClockSeconds () - start;
+
+        for (size_t i = 0; i < parallel.size (); ++i)
+        {
+            const std::string& checker_name = parallel.getChecker (i)->checkerName;
+            if (!parallel.getError (i).empty ())
             {
-              std::cout
-                << "[Compass] [Main] "
-                << "Running checker "
-                << (*itr)->checkerName.c_str ()
-                << std::endl;
+                std::cerr
+                  << "[Compass] [Main] "
+                  << "error running checker : "
+                  << checker_name
+                  << " - reason: "
+                  << parallel.getError (i)
+                  << std::endl;
+
+                errors.push_back (
+                  std::make_pair (checker_name,
+                  parallel.getError (i)));
             }
+            timings.push_back (std::make_pair (checker_name, parallel.getSeconds (i)));
+        }
+        timings.push_back (std::make_pair (std::string ("(parallel traversal)"), elapsed));
+    }
 
-            try
+    if (combined.size () > 0)
+    {
+        if (SgProject::get_verbose () >= 0)
+        {
+            for (size_t i = 0; i < combined.size (); ++i)
             {
-                int spaceAvailable = 40;
-                std::string name = (*itr)->checkerName + ":";
-                int n = spaceAvailable - name.length();
-                //Liao, 4/3/2008, bug 82, negative value
-                if (n<0) n=0;
-                std::string spaces(n,' ');
-
-                // -------------------------------------------------------------
-                //  !! PERFORM TRAVERSAL !!
-                // -------------------------------------------------------------
-                (*itr)->run (params, &output);
+                std::cout
+                  << "[Compass] [Main] "
+                  << "Running checker "
+                  << combined.getChecker (i)->checkerName.c_str ()
+                  << " (fused)"
+                  << std::endl;
             }
-            catch (const std::exception& e)
+        }
+
+        // ---------------------------------------------------------------------
+        //  !! PERFORM FUSED TRAVERSAL !!
+        // ---------------------------------------------------------------------
+        double start = Compass::wallClockSeconds ();
+        combined.run (project);
+        double elapsed = Compass::wallClockSeconds () - start;
+
+        for (size_t i = 0; i < combined.size (); ++i)
+        {
+            const std::string& checker_name = combined.getChecker (i)->checkerName;
+            if (!combined.getError (i).empty ())
             {
                 std::cerr
                   << "[Compass] [Main] "
                   << "error running checker : "
-                  << (*itr)->checkerName
+                  << checker_name
                   << " - reason: "
-                  << e.what()
+                  << combined.getError (i)
                   << std::endl;
 
-                errors.push_back(
-                  std::make_pair((*itr)->checkerName,
-                  e.what()));
+                errors.push_back (
+                  std::make_pair (checker_name,
+                  combined.getError (i)));
             }
+            timings.push_back (std::make_pair (checker_name, combined.getSeconds (i)));
+        }
+        timings.push_back (std::make_pair (std::string ("(fused traversal)"), elapsed));
+    }
+
+    for (std::vector<const Compass::Checker*>::iterator itr = standalone.begin();
+         itr != standalone.end();
+         ++itr)
+    {
+        if (SgProject::get_verbose () >= 0)
+        {
+          std::cout
+            << "[Compass] [Main] "
+            << "Running checker "
+            << (*itr)->checkerName.c_str ()
+            << std::endl;
+        }
+
+        double start = Compass::wallClockSeconds ();
+        try
+        {
+            // -----------------------------------------------------------------
+            //  !! PERFORM TRAVERSAL !!
+            // -----------------------------------------------------------------
+            (*itr)->run (params, &output);
         }
-    }//for each checker traversal
+        catch (const std::exception& e)
+        {
+            std::cerr
+              << "[Compass] [Main] "
+              << "error running checker : "
+              << (*itr)->checkerName
+              << " - reason: "
+              << e.what()
+              << std::endl;
+
+            errors.push_back(
+              std::make_pair((*itr)->checkerName,
+              e.what()));
+        }
+        timings.push_back (
+          std::make_pair ((*itr)->checkerName,
+          Compass::wallClockSeconds () - start));
+    }//for each standalone checker
+
+    if (print_timing)
+    {
+        // Time spent inside a fused or parallel checker excludes the shared
+        // walk itself, which is reported separately.  For parallel checkers
+        // it is summed over all threads.
+        std::vector<std::pair<std::string, double> >::iterator t_itr;
+        for (t_itr = timings.begin(); t_itr != timings.end(); ++t_itr)
+        {
+            int spaceAvailable = 40;
+            std::string name = t_itr->first + ":";
+            int n = spaceAvailable - name.length();
+            //Liao, 4/3/2008, bug 82, negative value
+            if (n<0) n=0;
+            std::string spaces(n,' ');
+
+            std::cout
+              << "[Compass] [Timing] "
+              << name << spaces << t_itr->second << " seconds"
+              << std::endl;
+        }
+    }
 
     // Output errors specific to any checkers that didn't initialize properly
     if (!errors.empty ())
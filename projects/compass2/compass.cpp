@@ -13,12 +13,16 @@
 #include <sstream>
 #include <fstream>
 #include <iostream>
+#include <algorithm>
+#include <time.h>
 
 /*-----------------------------------------------------------------------------
  * Library includes
  **--------------------------------------------------------------------------*/
 // Boost C++ libraries
 #include "boost/filesystem/operations.hpp"
+#include <boost/bind.hpp>
+#include <boost/thread.hpp>
 
 /*-----------------------------------------------------------------------------
  * Project includes
@@ -309,6 +313,131 @@ void Compass::runCheckerAndPrereqs(const Checker* checker, SgProject* proj, Para
   checker->run(params, output);
 }
 
+double Compass::wallClockSeconds() {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec + 1e-9 * ts.tv_nsec;
+}
+
+Compass::CombinedCheckerTraversal::CombinedCheckerTraversal(bool timing)
+  : timing(timing) {}
+
+Compass::CombinedCheckerTraversal::~CombinedCheckerTraversal() {
+  for (size_t i = 0; i < entries.size(); ++i)
+    delete entries[i].traversal;
+}
+
+bool Compass::CombinedCheckerTraversal::addChecker(const Checker* checker, Parameters params, OutputObject* output) {
+  const CheckerUsingAstSimpleProcessing* astChecker = dynamic_cast<const CheckerUsingAstSimpleProcessing*>(checker);
+  if (astChecker == NULL || astChecker->createSimpleTraversal.empty())
+    return false;
+  AstSimpleProcessingWithRunFunction* traversal = astChecker->createSimpleTraversal(params, output);
+  if (traversal == NULL)
+    return false;
+
+  Entry entry;
+  entry.checker = checker;
+  entry.traversal = traversal;
+  entry.seconds = 0.0;
+  entry.failed = false;
+  entries.push_back(entry);
+  addTraversal(traversal);
+  return true;
+}
+
+void Compass::CombinedCheckerTraversal::visit(SgNode* node) {
+  // Same as AstCombinedSimpleProcessing::visit(), except that a checker's exception only stops that checker.
+  for (std::vector<Entry>::iterator e = entries.begin(); e != entries.end(); ++e) {
+    if (e->failed)
+      continue;
+    double start = timing ? wallClockSeconds() : 0.0;
+    try {
+      e->traversal->visit(node);
+    } catch (const std::exception& ex) {
+      e->failed = true;
+      e->error = ex.what();
+    }
+    if (timing)
+      e->seconds += wallClockSeconds() - start;
+  }
+}
+
+Compass::ParallelCheckerTraversal::ParallelCheckerTraversal(size_t nThreads, bool timing)
+  : nThreads(nThreads), timing(timing), nextFile(0) {
+  if (this->nThreads == 0)
+    this->nThreads = std::max(boost::thread::hardware_concurrency(), 1u);
+}
+
+bool Compass::ParallelCheckerTraversal::addChecker(const Checker* checker, Parameters params) {
+  const CheckerUsingAstSimpleProcessing* astChecker = dynamic_cast<const CheckerUsingAstSimpleProcessing*>(checker);
+  if (astChecker == NULL || !astChecker->threadSafe || astChecker->createSimpleTraversal.empty())
+    return false;
+
+  // Some checkers return no traversal even though they have a creation function.
+  BufferingOutputObject unused;
+  AstSimpleProcessingWithRunFunction* traversal = astChecker->createSimpleTraversal(params, &unused);
+  if (traversal == NULL)
+    return false;
+  delete traversal;
+
+  checkers.push_back(checker);
+  parameters.push_back(params);
+  seconds.push_back(0.0);
+  errors.push_back(std::string());
+  return true;
+}
+
+void Compass::ParallelCheckerTraversal::processFiles(const std::vector<SgFile*>* files,
+                                                     std::vector<CombinedCheckerTraversal*>* traversals) {
+  while (true) {
+    size_t i;
+    {
+      boost::mutex::scoped_lock lock(mutex);
+      if (nextFile >= files->size())
+        return;
+      i = nextFile++;
+    }
+    (*traversals)[i]->run((*files)[i]);
+  }
+}
+
+void Compass::ParallelCheckerTraversal::run(SgProject* project, OutputObject* output) {
+  ROSE_ASSERT(project != NULL);
+  std::vector<SgFile*> files = project->get_fileList();
+  if (checkers.empty() || files.empty())
+    return;
+
+  // The traversals are created before any thread starts because checkers initialize shared state (such as their
+  // source directory) when their traversal is created.
+  std::vector<BufferingOutputObject> buffers(files.size());
+  std::vector<CombinedCheckerTraversal*> traversals(files.size());
+  for (size_t i = 0; i < files.size(); ++i) {
+    traversals[i] = new CombinedCheckerTraversal(timing);
+    for (size_t j = 0; j < checkers.size(); ++j) {
+      bool added = traversals[i]->addChecker(checkers[j], parameters[j], &buffers[i]);
+      ROSE_ASSERT(added);
+    }
+  }
+
+  nextFile = 0;
+  size_t nWorkers = std::min(nThreads, files.size());
+  boost::thread_group workers;
+  for (size_t i = 1; i < nWorkers; ++i)
+    workers.create_thread(boost::bind(&ParallelCheckerTraversal::processFiles, this, &files, &traversals));
+  processFiles(&files, &traversals);
+  workers.join_all();
+
+  for (size_t i = 0; i < files.size(); ++i) {
+    buffers[i].flush(output);
+    for (size_t j = 0; j < checkers.size(); ++j) {
+      seconds[j] += traversals[i]->getSeconds(j);
+      if (errors[j].empty())
+        errors[j] = traversals[i]->getError(j);
+    }
+    delete traversals[i];
+  }
+}
+
 namespace Compass
 {
 
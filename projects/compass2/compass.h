@@ -22,6 +22,7 @@
 #include <boost/algorithm/string.hpp>
 #include <boost/foreach.hpp>
 #include <boost/regex.hpp>
+#include <boost/thread/mutex.hpp>
 
 // Xerces-C XML libraries
 #include <xercesc/parsers/XercesDOMParser.hpp>
@@ -757,6 +758,25 @@ namespace Xml
         std::ostream& stream;
     };// end PrintingOutputObject class
 
+  /** An output object which saves each error message until flush() passes
+    * them on, in the order they were added, to another output object.
+    */
+  class BufferingOutputObject: public OutputObject
+    {
+      public:
+        virtual void addOutput (OutputViolationBase* theOutput)
+          {
+            outputList.push_back(theOutput);
+          }
+
+        void flush (OutputObject* output)
+          {
+            for (size_t i = 0; i < outputList.size(); ++i)
+                output->addOutput(outputList[i]);
+            clear();
+          }
+    };// end BufferingOutputObject class
+
   /** \brief Format file info according to the GNU standard.
     *
     * See http://www.gnu.org/prep/standards/html_node/Errors.html
@@ -903,6 +923,13 @@ namespace Xml
         LanguageSet supportedLanguages;
         PrerequisiteList prerequisites;
         RunFunction run;
+
+        /** True if the checker only looks at the subtree it is given and
+          * its traversal may run on several threads at once (each with its
+          * own traversal object and output object).
+          */
+        bool threadSafe;
+
         virtual ~Checker() {} // Allow RTTI
 
       Checker(std::string checkerName,
@@ -910,13 +937,15 @@ namespace Xml
               std::string longDescription,
               LanguageSet supportedLanguages,
               const PrerequisiteList& prerequisites,
-              RunFunction run)
+              RunFunction run,
+              bool threadSafe = false)
         : checkerName (checkerName),
           shortDescription (shortDescription),
           longDescription (longDescription),
           supportedLanguages (supportedLanguages),
           prerequisites (prerequisites),
-          run (run)
+          run (run),
+          threadSafe (threadSafe)
         {}
     };// end Checker class
 
@@ -961,17 +990,127 @@ namespace Xml
             LanguageSet supportedLanguages,
             const PrerequisiteList& prerequisites,
             RunFunction run,
-            SimpleTraversalCreationFunction createSimpleTraversal)
+            SimpleTraversalCreationFunction createSimpleTraversal,
+            bool threadSafe = false)
           : Checker (checkerName,
                      shortDescription,
                      longDescription,
                      supportedLanguages,
                      prerequisites,
-                     run),
+                     run,
+                     threadSafe),
             createSimpleTraversal(createSimpleTraversal)
           {}
     };// end CheckerUsingAstSimpleProcessing class
 
+  /** Runs the traversals of several checkers in a single preorder walk of
+    * the AST, instead of one walk per checker.
+    *
+    * Only instances of CheckerUsingAstSimpleProcessing whose
+    * createSimpleTraversal() returns a traversal can be combined; addChecker()
+    * returns false for all others, which must be run on their own.  Each node
+    * is handed to the checkers in the order they were added.  A checker that
+    * throws is dropped for the rest of the walk and its error is recorded.
+    * When timing is enabled, the time spent in each checker's visit() is
+    * accumulated separately.
+    */
+  class CombinedCheckerTraversal: public AstCombinedSimpleProcessing
+    {
+      public:
+        explicit CombinedCheckerTraversal (bool timing = false);
+
+        //! Deletes the traversals created by addChecker()
+        virtual ~CombinedCheckerTraversal ();
+
+        //! Adds a checker's traversal, returning false if it cannot be combined
+        bool addChecker (const Checker* checker, Parameters params, OutputObject* output);
+
+        void run (SgNode* root)
+          {
+            this->traverse(root, preorder);
+          }
+
+        //! Number of checkers that were added
+        size_t size () const { return entries.size(); }
+
+        const Checker* getChecker (size_t i) const { return entries[i].checker; }
+
+        //! Seconds spent in the i'th checker, or zero if timing is disabled
+        double getSeconds (size_t i) const { return entries[i].seconds; }
+
+        //! Reason the i'th checker failed, or empty if it did not
+        const std::string& getError (size_t i) const { return entries[i].error; }
+
+      protected:
+        virtual void visit (SgNode* node);
+
+      private:
+        struct Entry
+          {
+            const Checker* checker;
+            AstSimpleProcessingWithRunFunction* traversal;
+            double seconds;
+            bool failed;
+            std::string error;
+          };
+
+        std::vector<Entry> entries;
+        bool timing;
+
+        DISALLOW_COPY_AND_ASSIGN(CombinedCheckerTraversal);
+    };// end CombinedCheckerTraversal class
+
+  /** Runs thread-safe checkers over each file of a project on several
+    * threads.
+    *
+    * Each file is walked once by a CombinedCheckerTraversal holding all
+    * added checkers, and files are handed out to the threads as they become
+    * idle.  Error messages are buffered per file and passed to the output
+    * object in the order of the project's file list once all files are done,
+    * so the output is the same as for a serial CombinedCheckerTraversal over
+    * the project regardless of the number of threads.  Only checkers that
+    * are marked threadSafe and provide a traversal can be added.
+    */
+  class ParallelCheckerTraversal
+    {
+      public:
+        //! Zero threads means one per hardware thread
+        ParallelCheckerTraversal (size_t nThreads = 0, bool timing = false);
+
+        //! Adds a checker, returning false if it cannot run in parallel
+        bool addChecker (const Checker* checker, Parameters params);
+
+        //! Runs the checkers over every file of the project, then emits their error messages to output
+        void run (SgProject* project, OutputObject* output);
+
+        size_t size () const { return checkers.size(); }
+
+        const Checker* getChecker (size_t i) const { return checkers[i]; }
+
+        //! Seconds spent in the i'th checker summed over all files, or zero if timing is disabled
+        double getSeconds (size_t i) const { return seconds[i]; }
+
+        //! Reason the i'th checker failed on some file, or empty if it did not
+        const std::string& getError (size_t i) const { return errors[i]; }
+
+      private:
+        // Walks the files claimed from nextFile until none are left.
+        void processFiles (const std::vector<SgFile*>* files,
+                           std::vector<CombinedCheckerTraversal*>* traversals);
+
+        size_t nThreads;
+        bool timing;
+        std::vector<const Checker*> checkers;
+        std::vector<Parameters> parameters;
+        std::vector<double> seconds;
+        std::vector<std::string> errors;
+
+        boost::mutex mutex;     // protects nextFile
+        size_t nextFile;
+
+        DISALLOW_COPY_AND_ASSIGN(ParallelCheckerTraversal);
+    };// end ParallelCheckerTraversal class
+
   /**--------------------------------------------------------------------
    *
    * End of AST group
@@ -1055,6 +1194,9 @@ namespace Xml
 
   //! Run a checker and its prerequisites
   void runCheckerAndPrereqs (const Checker* checker, SgProject* proj, Parameters params, OutputObject* output);
+
+  //! Seconds elapsed on a monotonic clock, for timing checkers
+  double wallClockSeconds ();
   /**--------------------------------------------------------------------
    *
    * End of Checkers group
@@ -0,0 +1,69 @@
+// Violations of several checkers, for comparing the ways checkers are run.
+
+#include <stdlib.h>
+#include <string.h>
+
+struct Point
+{
+  int x;
+  int y;
+};
+
+class Mixed
+{
+ public:
+  int visible;
+
+ private:
+  int hidden;
+};
+
+class Overloaded
+{
+ public:
+  bool operator&&(const Overloaded &other) const;
+};
+
+void no_prototype() {}
+
+int variadic(int count, ...);
+
+int with_default(int value = 3);
+
+int multiple_returns(int value)
+{
+  if (value > 10)
+    return 1;
+  return 0;
+}
+
+int main()
+{
+  int number = rand();
+  int *pointer = &number;
+  int size = sizeof(pointer);
+  int copy;
+
+  if (number = 7)
+    copy = 42;
+
+  if (pointer < &copy)
+    copy = 0;
+
+  double ratio = 0.5;
+  if (ratio == 0.25)
+    copy = 1;
+
+  for (float f = 0; f < 1; f += 0.5)
+    copy += 2;
+
+  while (number)
+    number--;
+
+  Point a, b;
+  if (memcmp(&a, &b, sizeof(a)) == 0)
+    goto done;
+
+done:
+  return size + copy;
+}
@@ -0,0 +1,23 @@
+// Violations of several checkers, for comparing the ways checkers are run.
+
+#include <unistd.h>
+
+class Owner
+{
+ public:
+  void destroy()
+  {
+    delete this;
+  }
+};
+
+int pick(int a, int b)
+{
+  return a > b ? a : b;
+}
+
+int spawn()
+{
+  pid_t pid = vfork();
+  return pid == 0 ? 17 : -1;
+}
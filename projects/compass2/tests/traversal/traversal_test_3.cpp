@@ -0,0 +1,26 @@
+// Violations of several checkers, for comparing the ways checkers are run.
+
+#include <stdlib.h>
+
+struct Pair
+{
+  int first;
+  int second;
+};
+
+int sequence(int a, int b)
+{
+  int c = (a++, b++);
+  return -c;
+}
+
+unsigned int negate(unsigned int value)
+{
+  return -value;
+}
+
+int random_size(Pair *pair)
+{
+  int size = sizeof(pair);
+  return size + rand() % 13;
+}
@@ -0,0 +1,24 @@
+// Violations of several checkers, for comparing the ways checkers are run.
+
+#include <stdarg.h>
+
+int sum(int count, ...)
+{
+  int total = 0;
+  va_list args;
+  va_start(args, count);
+  for (int i = 0; i < count; ++i)
+    total += va_arg(args, int);
+  va_end(args);
+  return total;
+}
+
+int loop(int limit)
+{
+  int i = 0;
+again:
+  if (!(i < limit))
+    return i;
+  i += 5;
+  goto again;
+}
@@ -191,7 +191,8 @@ public:
     /** Insert file contents into memory map.
      *
      *  Insert the contents of a file into the memory map at the specified address.  This is just a convenience wrapper that
-     *  creates a new MappedBuffer and inserts it into the mapping. Returns the size of the file mapping. */
+     *  creates a new MappedBuffer and inserts it into the mapping. A writable mapping is private (copy-on-write), so writing
+     *  to the memory map never modifies the file. Returns the size of the file mapping. */
     size_t insertFile(const std::string &fileName, rose_addr_t va, bool writable=false, std::string segmentName="");
 
     /** Insert file contents into memory map.
@@ -234,9 +235,11 @@ public:
      *     at the specified OFFSET but not exceeding a specified VMSIZE.  If this number of bytes cannot be read from the file
      *     then an error is thrown.
      *
-     * @li @c FILENAME: Name of file to read. The file must be readable by the user and its contents are copied into the memory
-     *     map.  Once inside the memory map, the segment can be given any accessibility according to PERM.  The name of the
-     *     segment will be the non-directory part of the FILENAME (e.g., on POSIX systems, the part after the final slash).
+     * @li @c FILENAME: Name of file to read. The file must be readable by the user.  On POSIX systems the contents of a
+     *     regular file are mapped privately (copy-on-write) into the memory map, so writing to the memory map never changes the
+     *     file; the contents of other files (devices, pipes, etc.) are copied into the memory map.  Once inside the memory map,
+     *     the segment can be given any accessibility according to PERM.  The name of the segment will be the non-directory
+     *     part of the FILENAME (e.g., on POSIX systems, the part after the final slash).
      *
      * @section exampes Examples
      *
@@ -6,6 +6,7 @@
 #include "Registers.h"
 #include "MemoryMap.h"
 #include "integerOps.h"
+#include "InstructionRecord.h"
 #include "Map.h"
 #include "BaseSemantics2.h"
 
@@ -520,6 +521,16 @@ public:
     SgAsmInstruction *disassembleOne(const unsigned char *buf, rose_addr_t buf_va, size_t buf_size, rose_addr_t start_va,
                                      AddressSet *successors=NULL);
 
+    /** Builds the AST for an instruction record.
+     *
+     *  Decodes the raw bytes stored in the record, so the memory map from which the record was created is not needed.  If the
+     *  bytes cannot be decoded (e.g., the record describes an "unknown" instruction) then an unknown instruction with the
+     *  record's raw bytes is returned.  Returns null for an empty record. The record must hold its raw bytes (see
+     *  InstructionRecord::hasBytes).
+     *
+     *  Thread safety: Same as disassembleOne(). */
+    SgAsmInstruction *buildAst(const InstructionRecord&);
+
     /** Like the disassembleOne method except it disassembles a basic block's worth of instructions beginning at the specified
      *  virtual address.  For the purposes of this function, a basic block is defined as starting from the specified
      *  instruction and continuing until we reach a branch instruction (e.g., "jmp", "je", "call", "ret", etc.), or an
@@ -19,11 +19,11 @@ class DisassemblerX86: public Disassembler {
      *========================================================================================================================*/
 public:
     DisassemblerX86(size_t wordsize)
-        : insnSize(x86_insnsize_none), ip(0), insnbufat(0), segOverride(x86_segreg_none),
+        : insnSize(x86_insnsize_none), ip(0), insnbufsz(0), insnbufat(0), segOverride(x86_segreg_none),
           branchPrediction(x86_branch_prediction_none), branchPredictionEnabled(false), rexPresent(false), rexW(false), 
           rexR(false), rexX(false), rexB(false), sizeMustBe64Bit(false), operandSizeOverride(false), addressSizeOverride(false),
           lock(false), repeatPrefix(x86_repeat_none), modregrmByteSet(false), modregrmByte(0), modeField(0), rmField(0), 
-          modrm(NULL), reg(NULL), isUnconditionalJump(false) {
+          modrm(NULL), reg(NULL), isUnconditionalJump(false), fastDecoderEnabled(true), regTableDictionary(NULL) {
         init(wordsize);
     }
 
@@ -41,6 +41,19 @@ public:
     /** Make an unknown instruction from an exception. */
     virtual SgAsmInstruction *make_unknown_instruction(const Exception&) ROSE_OVERRIDE;
 
+    /** Property: whether the fast decoder is used.
+     *
+     *  When enabled (the default), register operands are created from register descriptors that are looked up once per
+     *  register dictionary, and the bytes of each instruction are decoded from a fixed-size buffer.  When disabled, the
+     *  decoder works as it did before those changes: each register is looked up by name for each operand and the bytes are
+     *  copied into a heap-allocated buffer.  The instructions and exceptions are identical either way; disabling the fast
+     *  decoder is only useful for testing that they are.  The opcode decoding itself is the same in both cases.
+     *
+     * @{ */
+    bool useFastDecoder() const { return fastDecoderEnabled; }
+    void useFastDecoder(bool b) { fastDecoderEnabled = b; }
+    /** @} */
+
 
     /*========================================================================================================================
      * Data types
@@ -53,10 +66,10 @@ private:
     class ExceptionX86: public Exception {
     public:
         ExceptionX86(const std::string &mesg, const DisassemblerX86 *d)
-            : Exception(mesg, d->ip, d->insnbuf, 8*d->insnbufat)
+            : Exception(mesg, d->ip, d->instructionBytes(d->insnbufsz), 8*d->insnbufat)
             {}
         ExceptionX86(const std::string &mesg, const DisassemblerX86 *d, size_t bit)
-            : Exception(mesg, d->ip, d->insnbuf, bit)
+            : Exception(mesg, d->ip, d->instructionBytes(d->insnbufsz), bit)
             {}
     };
 
@@ -185,6 +198,12 @@ private:
      *  than one type. */
     SgAsmRegisterReferenceExpression *makeRegister(uint8_t fullRegisterNumber, RegisterMode, SgAsmType *registerType=NULL) const;
 
+    /** Name of a register in the register dictionary, or empty if the register number is out of range for the mode. */
+    static std::string registerName(uint8_t fullRegisterNumber, RegisterMode);
+
+    /** Precomputes the register descriptors used by makeRegister() from the current register dictionary. */
+    void buildRegisterTable() const;
+
     /* FIXME: documentation? */
     SgAsmRegisterReferenceExpression *makeRegisterEffective(uint8_t fullRegisterNumber) {
         return makeRegister(fullRegisterNumber, effectiveOperandMode());
@@ -362,10 +381,24 @@ private:
         segOverride = insn->get_segmentOverride();
     }
     
+    /** Returns the first @p n bytes of the instruction buffer. */
+    SgUnsignedCharList instructionBytes(size_t n) const {
+        if (fastDecoderEnabled)
+            return SgUnsignedCharList(insnbuf, insnbuf+n);
+        return SgUnsignedCharList(baselineInsnbuf.begin(), baselineInsnbuf.begin()+n);
+    }
+
     /** Resets disassembler state to beginning of an instruction for disassembly. */
     void startInstruction(rose_addr_t start_va, const uint8_t *buf, size_t bufsz) {
         ip = start_va;
-        insnbuf = SgUnsignedCharList(buf, buf+bufsz);
+        if (fastDecoderEnabled) {
+            insnbufsz = std::min(bufsz, sizeof insnbuf);
+            if (insnbufsz > 0)
+                memcpy(insnbuf, buf, insnbufsz);
+        } else {
+            baselineInsnbuf = SgUnsignedCharList(buf, buf+bufsz);
+            insnbufsz = bufsz;
+        }
         insnbufat = 0;
 
         /* Prefix flags */
@@ -389,7 +422,9 @@ private:
 
     /* Per-instruction settings; see startInstruction() */
     uint64_t ip;                                /**< Virtual address for start of instruction */
-    SgUnsignedCharList insnbuf;                 /**< Buffer containing bytes of instruction */
+    uint8_t insnbuf[16];                        /**< Buffer containing bytes of instruction */
+    SgUnsignedCharList baselineInsnbuf;         /**< Used instead of insnbuf when the fast decoder is disabled */
+    size_t insnbufsz;                           /**< Number of bytes in insnbuf or baselineInsnbuf */
     size_t insnbufat;                           /**< Index of next byte to be read from or write to insnbuf */
 
     /* Temporary flags set by the instruction; initialized by startInstruction() */
@@ -410,6 +445,11 @@ private:
     SgAsmExpression *modrm;                     /**< Register or memory ref expr built from modregrmByte; see getModRegRM() */
     SgAsmExpression *reg;                       /**< Register reference expression built from modregrmByte; see getModRegRM() */
     bool isUnconditionalJump;                   /**< True for jmp, farjmp, ret, retf, iret, and hlt */
+
+    /* Fast decoder settings: the precomputed register table (see buildRegisterTable()) and the fixed-size insnbuf */
+    bool fastDecoderEnabled;                    /**< Use the table and insnbuf; see useFastDecoder() */
+    mutable const RegisterDictionary *regTableDictionary; /**< Dictionary from which regTable was built, or null */
+    mutable RegisterDescriptor regTable[rmReturnNull][16]; /**< Descriptors by mode and register number; invalid if none */
 };
 
 } // namespace
@@ -0,0 +1,120 @@
+#ifndef ROSE_BinaryAnalysis_InstructionRecord_H
+#define ROSE_BinaryAnalysis_InstructionRecord_H
+
+#include "sage3basic.h"                                 // RegisterDescriptor, SgAsmInstruction, rose_addr_t
+
+#include <sawyer/Assert.h>
+
+namespace rose {
+namespace BinaryAnalysis {
+
+/** Compact description of one decoded instruction.
+ *
+ *  A full instruction is an SgAsmInstruction with an operand list and a tree of SgAsmExpression nodes per operand, all
+ *  allocated in the Sage memory pools. An instruction record is a fixed-size value with no heap storage that holds the
+ *  instruction's address, size, raw bytes, architecture-specific kind (see SgAsmInstruction::get_anyKind), and a
+ *  description of each operand.  Analyses that decode very many instructions but need the full AST for only a few of them
+ *  can keep records and call Disassembler::buildAst when an AST is needed.  Since the record holds the raw bytes, building
+ *  the AST doesn't need the memory map from which the instruction was decoded.
+ *
+ *  Operands that don't fit one of the simple forms (register, immediate, or memory reference whose address is a sum of a
+ *  base register, a scaled index register, and a constant) are described as @ref OP_OTHER; the AST is needed for details
+ *  about them. */
+class InstructionRecord {
+public:
+    enum {
+        MAX_SIZE = 24,                                  /**< Maximum number of raw bytes stored in a record. */
+        MAX_OPERANDS = 4                                /**< Maximum number of operands described by a record. */
+    };
+
+    /** Kind of operand. */
+    enum OperandType {
+        OP_NONE,                                        /**< No operand. */
+        OP_REGISTER,                                    /**< Register stored in @c reg. */
+        OP_IMMEDIATE,                                   /**< Constant stored in @c value. */
+        OP_MEMORY,                                      /**< Memory at @c segment:[reg + index*scale + value]. */
+        OP_OTHER                                        /**< Operand not described by the record. */
+    };
+
+    /** Description of one operand. */
+    struct Operand {
+        OperandType type;
+        size_t nBits;                                   /**< Width of the register, constant, or memory access. */
+        RegisterDescriptor reg;                         /**< Register operand, or base register of a memory operand. */
+        RegisterDescriptor index;                       /**< Index register of a memory operand. */
+        RegisterDescriptor segment;                     /**< Segment register of a memory operand. */
+        unsigned scale;                                 /**< Multiplier for the index register of a memory operand. */
+        uint64_t value;                                 /**< Immediate value, or displacement of a memory operand. */
+        Operand(): type(OP_NONE), nBits(0), scale(0), value(0) {}
+    };
+
+private:
+    rose_addr_t address_;
+    unsigned kind_;
+    size_t size_;
+    size_t nOperands_;
+    bool isUnknown_;
+    uint8_t bytes_[MAX_SIZE];
+    Operand operands_[MAX_OPERANDS];
+
+public:
+    /** Constructs an empty record.
+     *
+     *  An empty record has size zero and describes no instruction. */
+    InstructionRecord(): address_(0), kind_(0), size_(0), nOperands_(0), isUnknown_(false) {}
+
+    /** Constructs a record describing an instruction.
+     *
+     *  The instruction is not modified and is still owned by the caller. A null pointer results in an empty record. */
+    explicit InstructionRecord(SgAsmInstruction*);
+
+    /** True if this record describes an instruction. */
+    bool isEmpty() const { return 0 == size_; }
+
+    /** Starting address of the instruction. */
+    rose_addr_t address() const { return address_; }
+
+    /** Size of the instruction in bytes. */
+    size_t size() const { return size_; }
+
+    /** Architecture-specific kind of instruction.
+     *
+     *  This is the value returned by SgAsmInstruction::get_anyKind, such as an X86InstructionKind for x86 instructions. */
+    unsigned kind() const { return kind_; }
+
+    /** True if the instruction is an "unknown" instruction.
+     *
+     *  See SgAsmInstruction::isUnknown. */
+    bool isUnknown() const { return isUnknown_; }
+
+    /** True if the record holds all the raw bytes of the instruction.
+     *
+     *  Raw bytes are stored for instructions no longer than @ref MAX_SIZE bytes, which includes all instructions of the
+     *  architectures that ROSE supports. */
+    bool hasBytes() const { return size_ > 0 && size_ <= MAX_SIZE; }
+
+    /** Raw bytes of the instruction.
+     *
+     *  Only meaningful if @ref hasBytes is true. */
+    const uint8_t* bytes() const { return bytes_; }
+
+    /** Number of operands.
+     *
+     *  Instructions with more than @ref MAX_OPERANDS operands describe only the first ones. */
+    size_t nOperands() const { return nOperands_; }
+
+    /** Description of one operand. */
+    const Operand& operand(size_t i) const {
+        ASSERT_require(i < nOperands_);
+        return operands_[i];
+    }
+
+private:
+    static Operand describeOperand(SgAsmExpression*);
+    static bool addAddressTerm(SgAsmExpression*, Operand&);
+};
+
+} // namespace
+} // namespace
+
+#endif
@@ -42,8 +42,10 @@ class Engine {
     BinaryLoader *loader_;                              // how to remap, link, and fixup
     Disassembler *disassembler_;                        // not ref-counted yet, but don't destroy it since user owns it
     MemoryMap map_;                                     // memory map initialized by load()
+    size_t nThreads_;                                   // number of threads used for basic block discovery
+    bool evictInstructions_;                            // evict unattached instructions when the cache is over capacity
 public:
-    Engine(): interp_(NULL), loader_(NULL), disassembler_() {}
+    Engine(): interp_(NULL), loader_(NULL), disassembler_(), nThreads_(1), evictInstructions_(false) {}
 
     virtual ~Engine() {}
 
@@ -220,6 +222,29 @@ public:
     Engine& disassembler(Disassembler *d) { disassembler_ = d; return *this; }
     /** @} */
 
+    /** Property: number of threads for basic block discovery.
+     *
+     *  When greater than one, @ref discoverBasicBlocks uses @ref predecodeBasicBlocks to decode instructions for the pending
+     *  basic block placeholders in this many worker threads before committing the blocks to the CFG/AUM serially.  The
+     *  partitioning results are the same as for a single thread.  The default is one thread, which does no parallel work.
+     *
+     * @{ */
+    size_t nThreads() const { return nThreads_; }
+    Engine& nThreads(size_t n) { nThreads_ = std::max(n, (size_t)1); return *this; }
+    /** @} */
+
+    /** Property: evict unattached instructions during basic block discovery.
+     *
+     *  When set, @ref discoverBasicBlocks calls Partitioner::evictUnreferencedInstructions between blocks whenever the
+     *  instruction provider is over its @ref InstructionProvider::capacity "capacity".  Eviction deletes every cached
+     *  instruction that isn't attached to the CFG/AUM, so set this only if nothing outside the partitioner holds instructions
+     *  or basic blocks across calls to the engine (e.g., callbacks that remember detached blocks).  The default is off.
+     *
+     * @{ */
+    bool evictInstructions() const { return evictInstructions_; }
+    Engine& evictInstructions(bool b) { evictInstructions_ = b; return *this; }
+    /** @} */
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  High-level methods that mostly call low-level stuff
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -236,7 +261,12 @@ public:
      *  Processes the "undiscovered" work list until the list becomes empty.  This list is the list of basic block placeholders
      *  for which no attempt has been made to discover instructions.  This method implements a recursive descent disassembler,
      *  although it does not process the control flow edges in any particular order. Subclasses are expected to override this
-     *  to implement a more directed approach to discovering basic blocks. */
+     *  to implement a more directed approach to discovering basic blocks.
+     *
+     *  If the engine is configured to use more than one thread (see @ref nThreads) then each time the list is refilled the
+     *  instructions for its placeholders are first decoded in parallel by @ref predecodeBasicBlocks. The blocks themselves
+     *  are still made and attached to the CFG/AUM one at a time by @ref makeNextBasicBlock in the same order as the serial
+     *  algorithm, which obtains the instructions from the instruction provider's cache. */
     virtual void discoverBasicBlocks(Partitioner&);
 
     /** Discover as many functions as possible.
@@ -269,6 +299,19 @@ public:
      *  Returns the basic block that was discovered, or the null pointer if there are no pending undiscovered blocks. */
     virtual BasicBlock::Ptr makeNextBasicBlock(Partitioner&);
 
+    /** Decode instructions for pending basic blocks in parallel.
+     *
+     *  For each basic block placeholder that has no basic block yet and whose first instruction is not yet cached, copies the
+     *  bytes at that address from the instruction provider's memory map and decodes instructions along the fall-through path
+     *  from the placeholder in one of @ref nThreads worker threads, each using its own clone of the disassembler.  The decoded
+     *  instructions are then inserted into the partitioner's instruction provider in address order by the calling thread.  No
+     *  basic blocks are created and the CFG/AUM is not modified, so this can be called at any time without changing the
+     *  result of partitioning.  Instructions are only decoded where the copied bytes are sufficient to guarantee the same
+     *  result as decoding from the full memory map.
+     *
+     *  Returns the number of placeholders that were processed. */
+    virtual size_t predecodeBasicBlocks(Partitioner&);
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Methods to make functions.
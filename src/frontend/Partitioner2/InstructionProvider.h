@@ -8,6 +8,8 @@
 #include <sawyer/Map.h>
 #include <sawyer/SharedPointer.h>
 
+#include <boost/thread/mutex.hpp>
+
 namespace rose {
 namespace BinaryAnalysis {
 
@@ -22,25 +24,75 @@ namespace BinaryAnalysis {
  *  the user can initialize the cache explicitly and turn off the ability to call a disassembler.  A disassembler is always
  *  required regardless of whether its used to obtain new instructions because the disassembler has the canonical information
  *  about the machine architecture: what registers are defined, which registers are the program counter and stack pointer,
- *  which instruction semantics dispatcher can be used with the instructions, etc. */
+ *  which instruction semantics dispatcher can be used with the instructions, etc.
+ *
+ *  The cache can be shared by multiple threads (see @ref operator[]), and can optionally be bounded (see @ref capacity). */
 class InstructionProvider: public Sawyer::SharedObject {
 public:
     typedef Sawyer::SharedPointer<InstructionProvider> Ptr;
     typedef Sawyer::Container::Map<rose_addr_t, SgAsmInstruction*> InsnMap;
+    typedef Sawyer::Container::Map<rose_addr_t, InstructionRecord> RecordMap;
+
+    /** Cache statistics.
+     *
+     *  All counters accumulate from the time the provider is created or @ref resetStats is called. */
+    struct Stats {
+        size_t nHits;                                   /**< Lookups satisfied by the cache. */
+        size_t nMisses;                                 /**< Lookups not in the cache. */
+        size_t nDecoded;                                /**< Instructions produced by the disassembler. */
+        size_t nEvicted;                                /**< Cache entries removed by @ref evictUnreferenced. */
+        double decodeTime;                              /**< Seconds spent in the disassembler (summed over threads). */
+        Stats(): nHits(0), nMisses(0), nDecoded(0), nEvicted(0), decodeTime(0.0) {}
+    };
+
+    /** Predicate for @ref evictUnreferenced.
+     *
+     *  Returns true if the instruction is still referenced and must be kept in the cache. */
+    class IsReferenced {
+    public:
+        virtual ~IsReferenced() {}
+        virtual bool operator()(SgAsmInstruction*) const = 0;
+    };
 
 private:
+    // The cache is divided into shards by address so that threads looking up different addresses seldom contend for the same
+    // lock.  Each shard's mutex protects only that shard's map.
+    enum { NSHARDS = 64 };
+    struct Shard {
+        boost::mutex mutex;
+        InsnMap insns;
+        RecordMap records;                              // compact instructions whose ASTs are not cached
+    };
+
     Disassembler *disassembler_;
     MemoryMap memMap_;
-    mutable InsnMap insnMap_;                           // this is a cache
+    mutable Shard shards_[NSHARDS];                     // this is a cache
     bool useDisassembler_;
+    size_t capacity_;                                   // number of cached addresses before eviction is suggested; 0 = none
+
+    // Disassemblers are not thread safe, so each concurrent lookup that misses borrows one from this pool.  The pool starts
+    // with the user's disassembler and grows with clones (which we own) as needed.
+    mutable boost::mutex disassemblerMutex_;            // protects the following data members
+    mutable std::vector<Disassembler*> idleDisassemblers_;
+    mutable std::vector<Disassembler*> clonedDisassemblers_;
+
+    mutable boost::mutex statsMutex_;                   // protects the following data members
+    mutable size_t nCached_;
+    mutable size_t nKept_;                              // entries that survived the last eviction
+    mutable size_t nRecords_;                           // number of records in all shards
+    mutable Stats stats_;
 
 protected:
     InstructionProvider(Disassembler *disassembler, const MemoryMap &map)
-        : disassembler_(disassembler), memMap_(map), useDisassembler_(true) {
+        : disassembler_(disassembler), memMap_(map), useDisassembler_(true), capacity_(0), nCached_(0), nKept_(0),
+          nRecords_(0) {
         ASSERT_not_null(disassembler);
+        idleDisassemblers_.push_back(disassembler);
     }
 
 public:
+    ~InstructionProvider();
+
     /** Static allocating Constructor.
      *
      *  The disassembler is required even if the user plans to turn off the ability to obtain instructions from the
@@ -72,22 +124,98 @@ public:
      *  If the virtual address is non-executable then a null pointer is returned, otherwise either a valid instruction or an
      *  "unknown" instruction is returned.  An "unknown" instruction is used for cases where a valid instruction could not be
      *  disassembled, including the case when the first byte of a multi-byte instruction is executable but the remaining bytes
-     *  are not executable. */
+     *  are not executable.
+     *
+     *  Thread safety: This method can be called concurrently from multiple threads.  Each thread that needs to disassemble uses
+     *  its own clone of the disassembler.  If two threads miss on the same address at the same time then both decode it, but
+     *  only the first instruction is cached and both threads return it. */
     SgAsmInstruction* operator[](rose_addr_t va) const;
 
+    /** Insert an instruction into the cache.
+     *
+     *  Adds an instruction that was obtained some other way (e.g., decoded by another thread with a clone of this provider's
+     *  disassembler) to the cache so that @ref operator[] returns it instead of calling the disassembler.  The instruction
+     *  must be the same as what the disassembler would have produced from this provider's memory map.  Returns true if the
+     *  instruction was inserted, or false if the address was already cached, in which case the cache is not changed and the
+     *  caller still owns the instruction.
+     *
+     *  Thread safety: This method is thread safe. */
+    bool insert(SgAsmInstruction*);
+
+    /** Returns true if the specified address is cached.
+     *
+     *  The address is cached if @ref operator[] has been called for it (whether or not an instruction exists there), or if an
+     *  instruction was explicitly inserted.
+     *
+     *  Thread safety: This method is thread safe. */
+    bool isCached(rose_addr_t va) const;
+
+    /** Returns the memory map.
+     *
+     *  This is the copy of the memory map from which instructions are disassembled. */
+    const MemoryMap& memoryMap() const { return memMap_; }
+
+    /** Property: cache capacity.
+     *
+     *  The number of cached addresses above which @ref isOverCapacity returns true.  The provider never evicts instructions on
+     *  its own since it can't know which instructions are still in use; the owner of the provider (e.g., the partitioner)
+     *  calls @ref evictUnreferenced when it's over capacity at a point where it knows which instructions are referenced.
+     *  Setting a capacity doesn't cause anything to be evicted by itself (see Partitioner2::Engine::evictInstructions).
+     *  Zero, the default, means the capacity is unlimited.
+     *
+     * @{ */
+    size_t capacity() const { return capacity_; }
+    void capacity(size_t n) { capacity_ = n; }
+    /** @} */
+
+    /** True if a capacity is set and the cache, counting both cached addresses and records of evicted instructions, exceeds it.
+     *
+     *  If the previous eviction had to keep more entries than the capacity (because they're all referenced), then the cache is
+     *  not considered to be over capacity again until it has doubled in size since that eviction.  This prevents repeated
+     *  eviction scans that can't remove anything. */
+    bool isOverCapacity() const;
+
+    /** Evict unreferenced instructions.
+     *
+     *  Removes from the cache all addresses for which no instruction exists and all instructions for which the predicate
+     *  returns false.  The evicted instructions are deleted, so the predicate must return true for every instruction that
+     *  might still be referenced, including instructions that this provider returned to callers outside the predicate's
+     *  knowledge.  Compact records (see InstructionRecord) of evicted instructions are kept so that @ref operator[] can rebuild
+     *  them without decoding from the memory map again.  Records count against the @ref capacity, so when a capacity is set
+     *  only as many are kept as fit in half the room left after eviction.  Returns the number of cache entries removed.
+     *
+     *  Thread safety: This method must not be called while other threads are using the provider. */
+    size_t evictUnreferenced(const IsReferenced&);
+
+    /** Cache statistics.
+     *
+     *  Thread safety: These methods are thread safe.
+     *
+     * @{ */
+    Stats stats() const;
+    void resetStats();
+    /** @} */
+
     /** Returns the disassembler.
      *
      *  Returns the disassembler pointer provided in the constructor.  The disassembler is not owned by this instruction
-     *  provider, but must not be freed until after the instruction provider is destroyed. */
+     *  provider, but must not be freed until after the instruction provider is destroyed. It is also used by @ref operator[]
+     *  and so must not be used directly while other threads might be looking up instructions. */
     Disassembler* disassembler() const { return disassembler_; }
 
+private:
+    Disassembler* borrowDisassembler() const;
+    void returnDisassembler(Disassembler*) const;
+
+public:
+
     /** Returns number of cached starting addresses.
      *
      *  The number of cached starting addresses includes those addresses where an instruction exists, and those addresses where
      *  an instruction is known to not exist.
      *
      *  This is a constant-time operation. */
-    size_t nCached() const { return insnMap_.size(); }
+    size_t nCached() const;
 
     /** Returns the register dictionary. */
     const RegisterDictionary* registerDictionary() const { return disassembler_->get_registers(); }
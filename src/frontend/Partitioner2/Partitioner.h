@@ -416,6 +416,16 @@ public:
      *  then that same instruction will be returned this time. */
     SgAsmInstruction* discoverInstruction(rose_addr_t startVa) const;
 
+    /** Evict instructions that are not attached to the CFG/AUM from the instruction cache.
+     *
+     *  Removes from the instruction provider's cache, and deletes, every cached instruction that is not attached to the
+     *  CFG/AUM.  This is how the cache is kept within its @ref InstructionProvider::capacity "capacity".  The partitioner
+     *  can't tell whether anything else still points to those instructions: basic blocks that have been discovered but are
+     *  not attached (including blocks that were detached and are held by the caller) and any instruction pointers the caller
+     *  obtained from @ref discoverInstruction become dangling.  The caller must therefore guarantee that it holds no such
+     *  references; the partitioner never calls this on its own. Returns the number of cache entries evicted. */
+    size_t evictUnreferencedInstructions();
+
 
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     //                                  Partitioner basic block placeholder operations
@@ -289,6 +289,18 @@
 // DQ (3/7/2010): This is no longer used (for several years) and we use an STL based implementation.
 // #define MAX_NUMBER_OF_MEMORY_BLOCKS        1000
 
+// Memory pool blocks are allocated in chunks of one or more blocks. The number of blocks per chunk grows with the size of
+// the pool up to this limit so that large ASTs don't require thousands of small ROSE_MALLOC calls per IR node type.
+#define MAX_CLASS_ALLOCATION_BLOCKS_PER_CHUNK 64
+
+// Use per-thread free lists in the IR node new and delete operators so that threads building ASTs concurrently only
+// contend for the per-class allocation mutex when moving a batch of objects to or from the global free list.  This
+// requires compiler support for "__thread" and is incompatible with the no-reuse mode (nodes are never put back in a pool).
+#if defined(HAVE_PTHREAD_H) && defined(__GNUC__) && !defined(ROSE_USE_MEMORY_POOL_NO_REUSE) && \
+    !defined(ROSE_SKIP_THREAD_LOCAL_MEMORY_POOLS)
+#define ROSE_USE_THREAD_LOCAL_MEMORY_POOLS 1
+#endif
+
 
 // DQ (9/231/2005): Map these to the C library memory alloction/deallocation functions.
 // These could use alternative allocators which allocate on page boundaries in the future.
@@ -0,0 +1,126 @@
+#ifndef VIRTUAL_CFG_CACHE_H
+#define VIRTUAL_CFG_CACHE_H
+
+#include "virtualCFG.h"
+
+#include <boost/unordered_map.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+class SgFunctionDefinition;
+
+namespace VirtualCFG {
+
+  //! A materialized copy of the virtual CFG for one or more functions.
+  //!
+  //! The virtual CFG normally recomputes a node's edges from the AST every time CFGNode::outEdges() or
+  //! CFGNode::inEdges() is called.  A CFGCache computes them once per function: every CFG node of the function gets a
+  //! dense integer ID and the edges are stored in compressed sparse row arrays indexed by those IDs.  A function is
+  //! added to the cache the first time one of its nodes is looked up (or explicitly with build()).
+  //!
+  //! While a cache is installed with CFGCache::Activate, CFGNode::outEdges() and CFGNode::inEdges() on the calling
+  //! thread are answered from the cache, so existing analyses benefit without change.  Clients that want to avoid
+  //! the per-call vector allocation can walk the graph by node ID with outTargets() and inSources().
+  //!
+  //! The cache does not observe arbitrary AST changes.  The SageInterface statement and expression mutators invalidate
+  //! the enclosing function of the active cache; code that changes the AST by other means must call invalidate()
+  //! (or clear()) itself.  Interprocedural virtual CFGs (virtualInterproceduralControlFlowGraphs) are never cached.
+  //!
+  //! A cache is not thread safe, but each thread may install its own cache.
+  class ROSE_DLL_API CFGCache {
+    public:
+    //! Dense identifier of a cached CFG node
+    typedef unsigned int NodeId;
+
+    //! Half-open range of node IDs, such as the targets of a node's outgoing edges
+    typedef std::pair<const NodeId*, const NodeId*> NodeIdRange;
+
+    //! Returned by nodeId() for nodes that cannot be cached
+    static const NodeId INVALID_ID = (NodeId)(-1);
+
+    //! Installs a cache as the one consulted by CFGNode::outEdges() and CFGNode::inEdges() for the calling thread.
+    //! The previously active cache (if any) is restored when this object is destroyed.
+    class Activate {
+      CFGCache *previous;
+      public:
+      explicit Activate(CFGCache *cache);
+      ~Activate();
+      private:
+      Activate(const Activate&);
+      Activate& operator=(const Activate&);
+    };
+
+    CFGCache();
+
+    //! The cache installed for the calling thread, or null
+    static CFGCache* active();
+
+    //! Invalidates the function containing @p node in the calling thread's active cache, if any.  This is called by
+    //! the SageInterface mutators and is cheap when no cache is active.
+    static void notifyModified(SgNode *node);
+
+    //! Adds a function to the cache if it is not already present
+    void build(SgFunctionDefinition*);
+
+    //! Removes the function containing @p node from the cache.  Its nodes will be recomputed the next time they are
+    //! looked up.
+    void invalidate(SgNode *node);
+
+    //! Removes all functions from the cache
+    void clear();
+
+    //! Number of node IDs currently in use
+    size_t nNodes() const { return nodes.size() - nDeadNodes; }
+
+    //! The ID of a CFG node, building the containing function's CFG if necessary.  Returns INVALID_ID for nodes that
+    //! are not in a function definition.
+    NodeId nodeId(const CFGNode&);
+
+    //! The CFG node having the specified ID
+    const CFGNode& node(NodeId id) const { return nodes[id]; }
+
+    //! Targets of the outgoing edges of a node, in the same order as CFGNode::outEdges()
+    NodeIdRange outTargets(NodeId id) const;
+
+    //! Sources of the incoming edges of a node, in the same order as CFGNode::inEdges()
+    NodeIdRange inSources(NodeId id) const;
+
+    //! Outgoing edges of a node, equal to what CFGNode::outEdges() computes from the AST
+    std::vector<CFGEdge> outEdges(NodeId id) const;
+
+    //! Incoming edges of a node, equal to what CFGNode::inEdges() computes from the AST
+    std::vector<CFGEdge> inEdges(NodeId id) const;
+
+    private:
+    CFGCache(const CFGCache&);
+    CFGCache& operator=(const CFGCache&);
+
+    // Assigns IDs to all CFG nodes of an AST node if it has none yet, appending it to the work list.
+    NodeId discover(SgNode*, std::vector<SgNode*> &worklist);
+
+    // Removes a built function from the cache.
+    void discard(SgFunctionDefinition*);
+
+    // Node IDs of a function are contiguous, [begin,end)
+    typedef std::pair<NodeId, NodeId> IdRange;
+
+    // Each AST node that has CFG nodes owns cfgIndexForEnd()+1 consecutive IDs starting at its base ID.
+    boost::unordered_map<SgNode*, NodeId> baseIds;
+
+    // Functions that have been built and the IDs they own.
+    std::map<SgFunctionDefinition*, IdRange> functions;
+
+    // The CFG node for each ID, and the CSR arrays.  outTargetIds[outOffsets[i]..outOffsets[i+1]) are the targets of
+    // the out edges of node i; likewise for in edges.
+    std::vector<CFGNode> nodes;
+    std::vector<size_t> outOffsets, inOffsets;
+    std::vector<NodeId> outTargetIds, inSourceIds;
+
+    // Number of IDs belonging to invalidated functions.  Their storage is reclaimed by clear().
+    size_t nDeadNodes;
+  };
+
+} // end namespace VirtualCFG
+
+#endif // VIRTUAL_CFG_CACHE_H
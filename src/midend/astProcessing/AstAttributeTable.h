@@ -0,0 +1,233 @@
+#ifndef ROSE_AstAttributeTable_H
+#define ROSE_AstAttributeTable_H
+
+// Dense attribute storage for AST nodes.
+//
+// The AstAttributeMechanism attached to an IR node is a map from attribute name to AstAttribute pointer that is allocated
+// separately for each node, and every lookup compares strings.  That is fine for a few attributes on a few nodes, but
+// analyses that attach an attribute to nearly every node of a large AST pay for one map per node, one heap-allocated
+// attribute per node, and a string comparison per lookup.
+//
+// The classes here store such attributes in side tables instead. Each node that has a dense attribute is given a small
+// integer ID (stored in the node, see SgNode::get_attributeId), and each attribute key has one vector of values indexed by
+// that ID.  A lookup is two array accesses.  Keys are interned: every AstAttributeKey constructed with the same name refers
+// to the same table, so keys can be created wherever they are needed.
+//
+//     static AstAttributeKey<int> depthKey("depth");
+//     depthKey.set(node, 5);
+//     if (const int *depth = depthKey.get(node))
+//         ...
+//
+// The string-based interface (SgNode::addNewAttribute, SgNode::getAttribute, etc.) is unaffected and can be used at the same
+// time, even with the same names; the two mechanisms do not share storage.
+//
+// Side tables grow to the largest ID of any node that has the attribute, so they are best suited to attributes that most
+// nodes of an AST have; rarely used attributes are better stored with the string-based interface.  The tables are not
+// synchronized: threads may read concurrently, but adding or erasing attributes and assigning node IDs must not race with
+// other accesses.
+
+// This header needs the definition of SgNode, so include "rose.h" (or "sage3basic.h" within the library) first.
+#include "rosedll.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+class SgNode;
+
+/** Dense IDs for AST nodes.
+ *
+ *  IDs are assigned on demand, starting at one, and are never reused.  A node keeps its ID until it is deleted, at which time
+ *  its dense attributes are erased (see release). Since a node's
+ *  ID is stored in the node itself, the ID is validated against the node to which it was assigned; this catches IDs that
+ *  were restored by AST file I/O from a different process. */
+class ROSE_DLL_API AstNodeIds {
+public:
+    /** ID of a node, or zero if the node has no ID. */
+    static unsigned get(const SgNode *node) {
+        if (!node)
+            return 0;
+        unsigned id = node->get_attributeId();
+        const std::vector<const SgNode*> &v = owners();
+        return id < v.size() && v[id] == node ? id : 0;
+    }
+
+    /** ID of a node, assigning one if necessary. */
+    static unsigned obtain(SgNode *node);
+
+    /** Removes a node's ID and all of its dense attributes.
+     *
+     *  The node's ID is not reused.  This is called by the SgNode destructor, so the registry never refers to deleted
+     *  nodes. */
+    static void release(SgNode *node);
+
+    /** One more than the largest ID that has been assigned. */
+    static size_t size() { return owners().size(); }
+
+private:
+    static std::vector<const SgNode*>& owners();
+};
+
+/** Type-independent part of an attribute side table.
+ *
+ *  There is one table per attribute name. Tables are created by AstAttributeKey and live until the end of the program. */
+class ROSE_DLL_API AstAttributeTableBase {
+    std::string name_;
+public:
+    explicit AstAttributeTableBase(const std::string &name): name_(name) {}
+    virtual ~AstAttributeTableBase() {}
+
+    /** Name with which the table's key was interned. */
+    const std::string& name() const { return name_; }
+
+    /** Type of the attribute values. */
+    virtual const std::type_info& valueType() const = 0;
+
+    /** Number of nodes that have this attribute. */
+    virtual size_t size() const = 0;
+
+    /** Approximate number of bytes used by the table. */
+    virtual size_t memoryUsage() const = 0;
+
+    /** Removes the attribute from the node with the specified ID.  Returns true if the node had the attribute. */
+    virtual bool erase(unsigned nodeId) = 0;
+
+    /** Removes the attribute from all nodes and releases the table's storage. */
+    virtual void clear() = 0;
+};
+
+/** Side table holding values of one attribute.
+ *
+ *  Values are default constructed when the table grows, so @p T must be default constructible and copyable. */
+template<class T>
+class AstAttributeTable: public AstAttributeTableBase {
+    std::vector<T> values_;
+    std::vector<bool> present_;
+    size_t nPresent_;
+
+public:
+    explicit AstAttributeTable(const std::string &name): AstAttributeTableBase(name), nPresent_(0) {}
+
+    virtual const std::type_info& valueType() const { return typeid(T); }
+    virtual size_t size() const { return nPresent_; }
+
+    virtual size_t memoryUsage() const {
+        return sizeof(*this) + values_.capacity() * sizeof(T) + present_.capacity() / 8;
+    }
+
+    /** Pointer to the value for a node ID, or null if the node doesn't have the attribute. */
+    const T* get(unsigned id) const {
+        return id != 0 && id < present_.size() && present_[id] ? &values_[id] : NULL;
+    }
+    T* get(unsigned id) {
+        return id != 0 && id < present_.size() && present_[id] ? &values_[id] : NULL;
+    }
+
+    /** Sets the value for a node ID. */
+    void set(unsigned id, const T &value) {
+        if (id >= values_.size()) {
+            size_t n = std::max((size_t)id + 1, AstNodeIds::size());
+            values_.resize(n);
+            present_.resize(n, false);
+        }
+        if (!present_[id]) {
+            present_[id] = true;
+            ++nPresent_;
+        }
+        values_[id] = value;
+    }
+
+    virtual bool erase(unsigned id) {
+        if (id == 0 || id >= present_.size() || !present_[id])
+            return false;
+        present_[id] = false;
+        values_[id] = T();
+        --nPresent_;
+        return true;
+    }
+
+    virtual void clear() {
+        std::vector<T>().swap(values_);
+        std::vector<bool>().swap(present_);
+        nPresent_ = 0;
+    }
+};
+
+/** Registry of interned attribute names and their side tables. */
+class ROSE_DLL_API AstAttributeKeys {
+public:
+    /** Table for a name, or null if no key with that name has been created. */
+    static AstAttributeTableBase* table(const std::string &name);
+
+    /** Table for a name, created by calling @p factory if it doesn't exist yet.
+     *
+     *  Throws std::logic_error if the name is already used by a key whose values have a different type. */
+    static AstAttributeTableBase* table(const std::string &name, const std::type_info&,
+                                        AstAttributeTableBase*(*factory)(const std::string&));
+
+    /** All tables, in the order their keys were first created. */
+    static const std::vector<AstAttributeTableBase*>& tables();
+
+    /** Removes all dense attributes from a node. */
+    static void eraseAll(SgNode*);
+
+    /** Approximate number of bytes used by all tables and the node ID registry. */
+    static size_t memoryUsage();
+};
+
+/** Typed, interned attribute key.
+ *
+ *  A key is a lightweight handle to the side table for its name; copying a key or constructing another key with the same
+ *  name and type refers to the same values. */
+template<class T>
+class AstAttributeKey {
+    AstAttributeTable<T> *table_;
+
+    static AstAttributeTableBase* makeTable(const std::string &name) {
+        return new AstAttributeTable<T>(name);
+    }
+
+public:
+    /** Interns a name.
+     *
+     *  Throws std::logic_error if the name was already interned with a different value type. */
+    explicit AstAttributeKey(const std::string &name)
+        : table_(static_cast<AstAttributeTable<T>*>(AstAttributeKeys::table(name, typeid(T), makeTable))) {}
+
+    /** Name of the attribute. */
+    const std::string& name() const { return table_->name(); }
+
+    /** True if the node has this attribute. */
+    bool exists(const SgNode *node) const { return get(node) != NULL; }
+
+    /** Pointer to the node's value, or null if the node doesn't have this attribute.
+     *
+     *  The pointer is invalidated when the attribute is set on a node that doesn't have it yet. */
+    const T* get(const SgNode *node) const { return table_->get(AstNodeIds::get(node)); }
+    T* get(SgNode *node) { return table_->get(AstNodeIds::get(node)); }
+
+    /** The node's value, or @p dflt if the node doesn't have this attribute. */
+    T getOptional(const SgNode *node, const T &dflt) const {
+        const T *value = get(node);
+        return value ? *value : dflt;
+    }
+
+    /** Sets the node's value, adding the attribute if necessary. */
+    void set(SgNode *node, const T &value) { table_->set(AstNodeIds::obtain(node), value); }
+
+    /** Removes the attribute from a node. Returns true if the node had it. */
+    bool erase(SgNode *node) { return table_->erase(AstNodeIds::get(node)); }
+
+    /** Removes this attribute from all nodes. */
+    void clear() { table_->clear(); }
+
+    /** Number of nodes that have this attribute. */
+    size_t size() const { return table_->size(); }
+
+    /** Approximate number of bytes used by this attribute's table. */
+    size_t memoryUsage() const { return table_->memoryUsage(); }
+};
+
+#endif
@@ -1373,7 +1373,13 @@ typedef boost::shared_ptr<class MemoryCellList> MemoryCellListPtr;
  *  for users to define their own subclasses and use them in the semantic framework.
  *
  *  This implementation stores memory cells in reverse chronological order: the most recently created cells appear at the
- *  beginning of the list.  Subclasses, of course, are free to reorder the list however they want. */
+ *  beginning of the list.  Subclasses, of course, are free to reorder the list however they want.
+ *
+ *  Scanning the list makes each read linear in the number of cells, which is quadratic over a long basic block or a function
+ *  that writes to many stack locations.  If the @p indexed property is set (see set_indexed()) then scan() uses an index
+ *  instead: cells whose addresses are concrete are kept in an interval map by the bytes they occupy, and only the cells with
+ *  non-concrete addresses are scanned.  Scans for non-concrete addresses still visit every cell.  The index doesn't change
+ *  the result of any scan. */
 class MemoryCellList: public MemoryState {
 public:
     typedef std::list<MemoryCellPtr> CellList;
@@ -1383,13 +1389,34 @@ protected:
     bool byte_restricted;                       // are cell values all exactly one byte wide?
     MemoryCellPtr latest_written_cell;          // the cell whose value was most recently written to, if any
 
+private:
+    // Index used by scan() when "indexed" is set.  Cells are numbered in chronological order; concrete cells are stored in
+    // an interval map by the addresses they occupy (keys have their sign bit flipped so that the signed address comparisons
+    // done by MemoryCell::may_alias are ordered like the keys), and all other cells are kept in chronological order.  The
+    // index is rebuilt lazily whenever it might be out of date with the cell list.
+    struct IndexedCell {
+        MemoryCellPtr cell;
+        size_t seq;
+        IndexedCell(): seq(0) {}
+        IndexedCell(const MemoryCellPtr &cell, size_t seq): cell(cell), seq(seq) {}
+        bool operator==(const IndexedCell &other) const { return cell==other.cell; }
+    };
+    typedef Sawyer::Container::Interval<uint64_t> CellInterval;
+    typedef Sawyer::Container::IntervalMap<CellInterval, IndexedCell> ConcreteCellIndex;
+    typedef std::vector<std::pair<size_t/*seq*/, MemoryCellPtr> > UnindexedCells;
+    bool indexed;
+    mutable ConcreteCellIndex concrete_index;
+    mutable UnindexedCells unindexed_cells;
+    mutable size_t index_ncells;                // size of cell list when index was updated, or -1 if index is invalid
+    mutable size_t index_nextseq;
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Real constructors
 protected:
     explicit MemoryCellList(const MemoryCellPtr &protocell)
         : MemoryState(protocell->get_address(), protocell->get_value()),
           protocell(protocell),
-          byte_restricted(true) {
+          byte_restricted(true), indexed(false), index_ncells((size_t)(-1)), index_nextseq(1) {
         ASSERT_not_null(protocell);
         ASSERT_not_null(protocell->get_address());
         ASSERT_not_null(protocell->get_value());
@@ -1398,11 +1425,12 @@ protected:
     MemoryCellList(const SValuePtr &addrProtoval, const SValuePtr &valProtoval)
         : MemoryState(addrProtoval, valProtoval),
           protocell(MemoryCell::instance(addrProtoval, valProtoval)),
-          byte_restricted(true) {}
+          byte_restricted(true), indexed(false), index_ncells((size_t)(-1)), index_nextseq(1) {}
 
     // deep-copy cell list so that modifying this new state does not modify the existing state
     MemoryCellList(const MemoryCellList &other)
-        : MemoryState(other), protocell(other.protocell), byte_restricted(other.byte_restricted) {
+        : MemoryState(other), protocell(other.protocell), byte_restricted(other.byte_restricted), indexed(other.indexed),
+          index_ncells((size_t)(-1)), index_nextseq(1) {
         for (CellList::const_iterator ci=other.cells.begin(); ci!=other.cells.end(); ++ci)
             cells.push_back((*ci)->clone());
     }
@@ -1461,6 +1489,7 @@ public:
     virtual void clear() ROSE_OVERRIDE {
         cells.clear();
         latest_written_cell.reset();
+        invalidate_index();
     }
 
     /** Read a value from memory.
@@ -1499,6 +1528,22 @@ public:
     virtual void set_byte_restricted(bool b) { byte_restricted = b; }
     /** @} */
 
+    /** Indicates whether scan() uses an address index.  The index makes scans for concrete addresses proportional to the
+     *  number of cells with non-concrete addresses rather than to the total number of cells.  The default is false.  The
+     *  index is kept up to date by readMemory(), writeMemory(), and insert_cell(), and is rebuilt after traverse(), after the
+     *  non-const get_cells() is called, or when the cell list changes size behind its back.  Subclasses that replace cells or
+     *  change cell addresses some other way must call invalidate_index().  Copies of the state inherit this setting.
+     * @{ */
+    virtual bool get_indexed() const { return indexed; }
+    virtual void set_indexed(bool b) { indexed = b; invalidate_index(); }
+    /** @} */
+
+    /** Adds a new cell to the front of the list and to the index. */
+    virtual void insert_cell(const MemoryCellPtr &cell);
+
+    /** Causes the index to be rebuilt before it is next used. */
+    void invalidate_index() const;
+
     /** Scans the cell list and returns entries that may alias the given address and value size. The scanning starts at the
      *  beginning of the list (which is normally stored in reverse chronological order) and continues until it reaches either
      *  the end, or a cell that must alias the specified address. If the last cell in the returned list must alias the
@@ -1513,13 +1558,14 @@ public:
         virtual void operator()(MemoryCellPtr&) = 0;
     };
 
-    /** Visit each memory cell. */
+    /** Visit each memory cell.  The visitor may change cell addresses, so the index is invalidated. */
     void traverse(Visitor &visitor);
 
-    /** Returns the list of all memory cells.
+    /** Returns the list of all memory cells.  The non-const version invalidates the index since the caller might modify the
+     *  list.
      * @{ */
     virtual const CellList& get_cells() const { return cells; }
-    virtual       CellList& get_cells()       { return cells; }
+    virtual       CellList& get_cells()       { invalidate_index(); return cells; }
     /** @} */
 
     /** Returns the cell most recently written. */
@@ -1528,6 +1574,13 @@ public:
     /** Returns the union of writer virtual addresses for cells that may alias the given address. */
     virtual std::set<rose_addr_t> get_latest_writers(const SValuePtr &addr, size_t nbits,
                                                      RiscOperators *addrOps, RiscOperators *valOps);
+
+private:
+    bool concrete_interval(const MemoryCellPtr&, CellInterval &interval /*out*/) const;
+    void index_cell(const MemoryCellPtr&) const;
+    void update_index() const;
+    bool indexed_scan(const MemoryCellPtr &tmpcell, const CellInterval&, RiscOperators *addrOps,
+                      CellList &retval /*out*/, bool &short_circuited /*out*/) const;
 };
 
 /******************************************************************************************************************
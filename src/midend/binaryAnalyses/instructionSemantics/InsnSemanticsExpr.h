@@ -108,6 +108,50 @@ struct Formatter {
     RenameMap renames;                          /**< Map for renaming variables to use smaller integers. */
 };
 
+/** Statistics for expression interning.
+ *
+ *  @sa set_interning */
+struct InternStats {
+    InternStats(): nlookups(0), nhits(0), nmemo_lookups(0), nmemo_hits(0), nlive(0) {}
+    size_t nlookups;                            /**< Number of times a node was looked up in the intern table. */
+    size_t nhits;                               /**< Number of lookups that found an existing equivalent node. */
+    size_t nmemo_lookups;                       /**< Number of times a new internal node checked the simplifier cache. */
+    size_t nmemo_hits;                          /**< Number of simplifications answered from the cache. */
+    size_t nlive;                               /**< Number of nodes currently in the intern table. */
+};
+
+/** Enables or disables interning of expressions.
+ *
+ *  When interning is enabled, InternalNode::create and the LeafNode constant constructors return an existing node whenever
+ *  one that is structurally equivalent already exists, so equal subexpressions are stored only once and two interned nodes
+ *  are equivalent exactly when they are the same node.  The results of simplifying newly created internal nodes are also
+ *  cached (a bounded cache keyed by operator, width, and children), so rebuilding an expression that was built before skips
+ *  the simplifier.
+ *
+ *  Each thread has its own intern table and simplifier cache, created when the thread first interns a node and destroyed
+ *  when the thread exits, since the reference counts of TreeNodePtr are not atomic.  The pointer-equality shortcut therefore
+ *  applies only to nodes interned by the same thread.  A node handed to another thread (with external synchronization) is
+ *  copied into that thread's table if it's used to build interned expressions there.
+ *  The table holds a reference to each of its nodes and periodically releases those that are no longer referenced by
+ *  anything else.
+ *
+ *  Because equivalent nodes are shared, a comment set on an interned node is visible through every expression that uses
+ *  it, and the comment supplied when creating a node is ignored if an equivalent node already exists.
+ *
+ *  Interning is disabled by default.  Nodes created while interning was disabled are never replaced by interned nodes, but
+ *  they can be children of interned nodes (such nodes are rebuilt with interned children when they are interned).
+ * @{ */
+void set_interning(bool);
+bool get_interning();
+/** @} */
+
+/** Returns the calling thread's interning statistics accumulated since the thread started or the last call to
+ *  reset_intern_stats(). The @p nlive member is always the current size of the thread's table. */
+InternStats get_intern_stats();
+
+/** Resets the calling thread's interning statistics. */
+void reset_intern_stats();
+
 /** Return type for visitors. */
 enum VisitAction {
     CONTINUE,                               /**< Continue the traversal as normal. */
@@ -139,8 +183,17 @@ protected:
     size_t nbits;               /**< Number of significant bits. Constant over the life of the node. */
     mutable std::string comment; /**< Optional comment. Only for debugging; not significant for any calculation. */
     mutable uint64_t hashval;   /**< Optional hash used as a quick way to indicate that two expressions are different. */
+    bool interned;              /**< True if this node is the canonical node for its structure. See set_interning(). */
+    size_t intern_id;           /**< Identifies the thread's intern table holding this node, or zero. */
+
+    friend class InternalNode;                          // for interning
 public:
-    TreeNode(size_t nbits, std::string comment=""): nbits(nbits), comment(comment), hashval(0) { ASSERT_require(nbits>0); }
+    TreeNode(size_t nbits, std::string comment="")
+        : nbits(nbits), comment(comment), hashval(0), interned(false), intern_id(0) { ASSERT_require(nbits>0); }
+
+    /** Returns true if this node is in an intern table.  Two nodes interned by the same thread are structurally equivalent if
+     *  and only if they are the same node. See set_interning(). */
+    bool is_interned() const { return interned; }
 
     /** Returns true if two expressions must be equal (cannot be unequal).  If an SMT solver is specified then that solver is
      * used to answer this question, otherwise equality is established by looking only at the structure of the two
@@ -445,28 +498,33 @@ public:
      *  @{ */
     static TreeNodePtr create(size_t nbits, Operator op, const std::string comment="") {
         InternalNodePtr retval(new InternalNode(nbits, op, comment));
-        return retval->simplifyTop();
+        return retval->canonicalize();
     }
     static TreeNodePtr create(size_t nbits, Operator op, const TreeNodePtr &a, const std::string comment="") {
         InternalNodePtr retval(new InternalNode(nbits, op, a, comment));
-        return retval->simplifyTop();
+        return retval->canonicalize();
     }
     static TreeNodePtr create(size_t nbits, Operator op, const TreeNodePtr &a, const TreeNodePtr &b,
                                   const std::string comment="") {
         InternalNodePtr retval(new InternalNode(nbits, op, a, b, comment));
-        return retval->simplifyTop();
+        return retval->canonicalize();
     }
     static TreeNodePtr create(size_t nbits, Operator op, const TreeNodePtr &a, const TreeNodePtr &b, const TreeNodePtr &c,
                                   const std::string comment="") {
         InternalNodePtr retval(new InternalNode(nbits, op, a, b, c, comment));
-        return retval->simplifyTop();
+        return retval->canonicalize();
     }
     static TreeNodePtr create(size_t nbits, Operator op, const TreeNodes &children, const std::string comment="") {
         InternalNodePtr retval(new InternalNode(nbits, op, children, comment));
-        return retval->simplifyTop();
+        return retval->canonicalize();
     }
     /** @} */
 
+    /** Returns the canonical node for an expression.  If interning is enabled, returns the interned node that is equivalent
+     *  to @p node, interning @p node (and, as necessary, its children) if no such node exists yet.  Otherwise returns @p
+     *  node. See set_interning(). */
+    static TreeNodePtr intern(const TreeNodePtr &node);
+
     /* see superclass, where these are pure virtual */
     virtual bool must_equal(const TreeNodePtr &other, SMTSolver*) const;
     virtual bool may_equal(const TreeNodePtr &other, SMTSolver*) const;
@@ -495,6 +553,10 @@ public:
     /** Simplifies the specified internal node. Returns a new node if necessary, otherwise returns this. */
     TreeNodePtr simplifyTop() const;
 
+    /** Simplifies a newly created node and, if interning is enabled, returns the equivalent interned node.  Simplification
+     *  results are looked up in, and added to, the simplifier cache. This is what the create() class methods use. */
+    TreeNodePtr canonicalize() const;
+
     /** Perform constant folding.  This method returns either a new expression (if changes were mde) or the original
      *  expression. The simplifier is specific to the kind of operation at the node being simplified. */
     TreeNodePtr constant_folding(const Simplifier &simplifier) const;
@@ -554,6 +616,8 @@ private:
 
     static uint64_t name_counter;
 
+    friend class InternalNode;                          // for interning
+
 public:
     /** Construct a new free variable with a specified number of significant bits. */
     static LeafNodePtr create_variable(size_t nbits, std::string comment="");
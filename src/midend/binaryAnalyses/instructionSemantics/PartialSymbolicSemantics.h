@@ -41,7 +41,21 @@ namespace InstructionSemantics {            // documented elsewhere
  *  whether the value is negated. */
 namespace PartialSymbolicSemantics {
 
+    /** Source of names for unknown values.  When thread-local storage is available each thread has its own counter, so
+     *  analyses can run in concurrent threads provided that they don't share values.  Otherwise there is one counter for the
+     *  whole process and next_name() increments it while holding a mutex. */
+#ifdef ROSE_THREAD_LOCAL_STORAGE
+    extern ROSE_THREAD_LOCAL_STORAGE uint64_t name_counter;
+#else
     extern uint64_t name_counter;
+#endif
+
+    /** Returns a new name for an unknown value.  This is thread safe. */
+#ifdef ROSE_THREAD_LOCAL_STORAGE
+    inline uint64_t next_name() { return ++name_counter; }
+#else
+    uint64_t next_name();
+#endif
 
     /** Formatter that renames variables on the fly.  When this formatter is used, named variables are renamed using
      *  lower numbers. This is useful for human-readable output because variable names tend to get very large (like
@@ -73,7 +87,7 @@ namespace PartialSymbolicSemantics {
                                              *    constants. */
 
         /** Construct a value that is unknown and unique. */
-        ValueType(): name(++name_counter), offset(0), negate(false) {}
+        ValueType(): name(next_name()), offset(0), negate(false) {}
 
         /** Copy-construct a value, truncating or extending at msb the source value. */
         template <size_t Len>
@@ -9,6 +9,7 @@
 #include "threadSupport.h"
 
 #include <inttypes.h>
+#include <map>
 
 namespace rose {
 namespace BinaryAnalysis {
@@ -34,17 +35,24 @@ public:
 
     /** SMT solver statistics. */
     struct Stats {
-        Stats(): ncalls(0), input_size(0), output_size(0) {}
-        size_t ncalls;                          /**< Number of times satisfiable() was called. */
+        Stats(): ncalls(0), input_size(0), output_size(0), ncache_hits(0), ncache_misses(0), nprocesses(0) {}
+        size_t ncalls;                          /**< Number of times the solver was actually invoked by satisfiable(). */
         size_t input_size;                      /**< Bytes of input generated for satisfiable(). */
         size_t output_size;                     /**< Amount of output produced by the SMT solver. */
+        size_t ncache_hits;                     /**< Number of queries answered from the query cache. */
+        size_t ncache_misses;                   /**< Number of cacheable queries that were not found in the cache. */
+        size_t nprocesses;                      /**< Number of solver processes started. */
     };
 
     typedef std::set<uint64_t> Definitions;     /**< Free variables that have been defined. */
 
-    SMTSolver(): debug(NULL) { init(); }
+    SMTSolver()
+        : persistent(false), cache_limit(DEFAULT_CACHE_LIMIT), debug(NULL),
+          session_pid(-1), session_fd(-1), session_output(NULL) {
+        init();
+    }
 
-    virtual ~SMTSolver() {}
+    virtual ~SMTSolver();
 
     /** Determines if expressions are trivially satisfiable or unsatisfiable.  If all expressions are known 1-bit values that
      *  are true, then this function returns SAT_YES.  If any expression is a known 1-bit value that is false, then this
@@ -99,6 +107,28 @@ public:
     /** Clears evidence information. */
     virtual void clear_evidence() {}
 
+    /** Property: persistent solver session.  When set, and if the solver supports it (see get_session_command()), a single
+     *  solver process is started the first time it's needed and is kept alive for subsequent queries instead of starting a
+     *  new process and writing a temporary file for every query.  Free variables are defined once per session and each query's
+     *  assertions are wrapped in a push/pop pair so they don't accumulate.  If the session fails for any reason it is closed
+     *  and the query is retried the usual way. The default is to not use a persistent session.
+     * @{ */
+    void set_persistent(bool b) { persistent = b; if (!b) close_session(); }
+    bool get_persistent() const { return persistent; }
+    /** @} */
+
+    /** Property: maximum size of the query cache.  Results of satisfiable() are cached by the structural hash of the
+     *  expressions (which are compared for equivalence on a hit, so hash collisions are harmless), and the solver output is
+     *  cached along with the result so that evidence is still available when a query is answered from the cache.  The cache
+     *  is discarded when it reaches this many entries. A limit of zero disables the cache.
+     * @{ */
+    void set_cache_limit(size_t n) { cache_limit = n; if (cache.size() > n) clear_cache(); }
+    size_t get_cache_limit() const { return cache_limit; }
+    /** @} */
+
+    /** Discards all cached query results. */
+    void clear_cache() { cache.clear(); }
+
     /** Turns debugging on or off. */
     void set_debug(FILE *f) { debug = f; }
 
@@ -130,6 +160,33 @@ protected:
      *  expression.  This information is parsed by this function and added to a mapping of variable to value. */
     virtual void parse_evidence() {};
 
+    /** Returns the command that starts a persistent solver session.  The solver must read commands from standard input and
+     *  write results to standard output.  The default implementation returns an empty string, which means that the solver
+     *  does not support persistent sessions. */
+    virtual std::string get_session_command() { return ""; }
+
+    /** Generates the input for one query of a persistent session.  Definitions for free variables that are not yet in @p
+     *  defns are emitted and added to @p defns, which lives as long as the session.  The assertions must be scoped so that
+     *  they don't affect later queries, and the input must end with a command that causes the solver to print a line
+     *  containing only SESSION_END_MARKER after it has printed its result and evidence. */
+    virtual void generate_session_input(std::ostream&, const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs,
+                                        Definitions *defns) {
+        throw Exception("persistent sessions are not supported by this solver");
+    }
+
+    /** Line printed by the solver at the end of each persistent session query. */
+    static const char *SESSION_END_MARKER;
+
+    /** Looks up a query in the cache.  If the query is found then its result is returned in @p result, the output text of the
+     *  original query is restored, and evidence is parsed for satisfiable queries. Statistics are updated either way. */
+    bool cache_lookup(const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs, Satisfiable &result /*out*/);
+
+    /** Adds a query result and the current output_text to the cache. */
+    void cache_insert(const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs, Satisfiable result);
+
+    /** Stops the persistent solver process, if any. */
+    void close_session();
+
     /** Additional output obtained by satisfiable(). */
     std::string output_text;
 
@@ -139,8 +196,31 @@ protected:
     Stats stats;
 
 private:
+    enum { DEFAULT_CACHE_LIMIT = 100000 };
+
+    struct CacheEntry {
+        std::vector<InsnSemanticsExpr::TreeNodePtr> exprs; // sorted by hash
+        Satisfiable result;
+        std::string output_text;
+    };
+    typedef std::multimap<uint64_t/*combined hash*/, CacheEntry> Cache;
+
+    bool persistent;
+    size_t cache_limit;
+    Cache cache;
     FILE *debug;
+
+    // Persistent session state
+    int session_pid;                            // process ID of the solver, or -1
+    int session_fd;                             // our end of the socket connected to the solver's stdin and stdout
+    FILE *session_output;                       // buffered reader for session_fd
+    Definitions session_defns;                  // variables defined so far in the session
+
     void init();
+    Satisfiable run_file(const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs);
+    bool run_session(const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs, Satisfiable &result /*out*/);
+    bool open_session();
+    static uint64_t cache_key(std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs /*in,out*/);
 };
 
 } // namespace
@@ -35,6 +35,9 @@ public:
 
     virtual void generate_file(std::ostream&, const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs, Definitions*);
     virtual std::string get_command(const std::string &config_name);
+    virtual std::string get_session_command() /*overrides*/;
+    virtual void generate_session_input(std::ostream&, const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs,
+                                        Definitions*) /*overrides*/;
 
     /** Returns a bit vector indicating what calling modes are available.  The bits are defined by the LinkMode enum. */
     static unsigned available_linkage();
@@ -53,7 +56,8 @@ public:
     /** Determines if the specified expression is satisfiable.  Most solvers use the implementation in the base class, which
      *  creates a text file (usually in SMT-LIB format) and then invokes an executable with that input, looking for a line of
      *  output containing "sat" or "unsat". However, Yices provides a library that can optionally be linked into ROSE, and
-     *  uses this library if the link mode is LM_LIBRARY.
+     *  uses this library if the link mode is LM_LIBRARY.  When the solver is persistent (see SMTSolver::set_persistent()) the
+     *  library context is reused across queries with push/pop instead of being reset each time.
      *  @{ */
     virtual Satisfiable satisfiable(const std::vector<InsnSemanticsExpr::TreeNodePtr> &exprs);
     virtual Satisfiable satisfiable(const InsnSemanticsExpr::TreeNodePtr &tn) {
@@ -106,6 +110,7 @@ private:
     typedef yices_expr (*ShiftAPI)(yices_context, yices_expr, unsigned amount);
 
     yices_context context;
+    Definitions context_defns;                  // variables declared in the context since it was last reset
     void ctx_define(const InsnSemanticsExpr::TreeNodePtr&, Definitions*);
     void ctx_assert(const InsnSemanticsExpr::TreeNodePtr&);
     yices_expr ctx_expr(const InsnSemanticsExpr::TreeNodePtr&);
@@ -26,6 +26,39 @@ typedef Rose_STL_Container<SgClassDefinition *> SgClassDefinitionPtrList;
 // This header has to be here since it uses type SgFunctionDeclarationPtrList 
 #include "ClassHierarchyGraph.h"
 
+//! Function declarations indexed by the mangled name of their type.
+//!
+//! Resolving a call through a function pointer means finding every function whose type matches the pointer's.  Doing
+//! that with a memory pool query costs a pass over all function declarations per call site, which makes call graph
+//! construction quadratic for programs with many indirect calls.  This index makes that pass once and answers each
+//! lookup with a single hash table probe.  The declarations for each type are kept in memory pool order, so results
+//! are the same as those of the memory pool query.
+//!
+//! The index reflects the AST at the time it was built; it must be rebuilt if function declarations are added or
+//! removed afterward.  Normally it is obtained from ClassHierarchyWrapper::getFunctionTypeIndex().
+class ROSE_DLL_API FunctionTypeIndex
+{
+  public:
+    //! Indexes all function declarations (including template instantiations) in the memory pool.
+    FunctionTypeIndex();
+
+    //! All declarations whose type has the same mangled name as @p functionType.
+    const SgFunctionDeclarationPtrList& getDeclarations(SgFunctionType *functionType) const;
+
+    //! Number of distinct function types that have at least one declaration.
+    size_t size() const { return index.size(); }
+
+  private:
+    struct Entry
+    {
+      SgFunctionDeclarationPtrList declarations;
+    };
+
+    const Entry* find(SgFunctionType*) const;
+
+    typedef boost::unordered_map<std::string, Entry> Index;
+    Index index;
+};
 
 //AS(090707) Added the CallTargetSet namespace to replace the CallGraphFunctionSolver class
 namespace CallTargetSet
@@ -35,6 +68,9 @@ namespace CallTargetSet
   // returns the list of declarations of all functions that may get called via the specified pointer
   std::vector<SgFunctionDeclaration*> solveFunctionPointerCall ( SgPointerDerefExp *, SgProject * );
 
+  // same as above, but looks up the candidates in an index instead of querying the memory pool
+  std::vector<SgFunctionDeclaration*> solveFunctionPointerCall ( SgPointerDerefExp *, const FunctionTypeIndex & );
+
   // returns the list of declarations of all functions that may get called via a member function pointer
   std::vector<SgFunctionDeclaration*> solveMemberFunctionPointerCall ( SgExpression *,ClassHierarchyWrapper * );
   Rose_STL_Container<SgFunctionDeclaration*> solveFunctionPointerCallsFunctional(SgNode* node, SgFunctionType* functionType );
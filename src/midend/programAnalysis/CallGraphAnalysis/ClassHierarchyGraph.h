@@ -4,6 +4,9 @@
 #include <vector>
 #include <map>
 #include <boost/unordered_set.hpp>
+#include <boost/shared_ptr.hpp>
+
+class FunctionTypeIndex;
 
 class ROSE_DLL_API ClassHierarchyWrapper
 {
@@ -29,6 +32,9 @@ private:
 
     SgIncidenceDirectedGraph* classGraph;
 
+    /** Function declarations by type, built the first time it is needed. */
+    mutable boost::shared_ptr<FunctionTypeIndex> functionTypeIndex;
+
 public:
 
     ClassHierarchyWrapper(SgNode *node);
@@ -36,6 +42,10 @@ public:
     const ClassDefSet& getDirectSubclasses(SgClassDefinition *) const;
     const ClassDefSet& getAncestorClasses(SgClassDefinition *) const;
 
+    /** Index of all function declarations by type, used to resolve calls through function pointers. It is built on the
+     *  first call and shared by copies of this object. The first call is not thread safe. */
+    const FunctionTypeIndex& getFunctionTypeIndex() const;
+
 private:
 
     /** Computes the transitive closure of the child-parent class relationship.
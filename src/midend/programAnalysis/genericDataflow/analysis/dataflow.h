@@ -11,6 +11,7 @@
 #include <vector>
 #include <set>
 #include <map>
+#include <list>
 #include <string>
 
 // !!! NOTE: THE CURRENT INTER-/INTRA-PROCEDURAL ANALYSIS API EFFECTIVELY ASSUMES THAT EACH ANALYSIS WILL BE EXECUTED
@@ -501,6 +502,101 @@ class ContextInsensitiveInterProceduralDataflow : virtual public InterProcedural
 
         // Runs the intra-procedural analysis every time TraverseCallGraphDataflow passes a function.
         void visit(const CGFunction* func);
+
+        protected:
+        // Propagates the caller's dataflow state at a call site (dfInfo) into the state before the callee, scheduling
+        // the callee for re-analysis if that state changes. Returns true if the callee's state was modified.
+        virtual bool propagateToCallee(const Function& caller, const Function& callee, SgFunctionCallExp* call,
+                                       const std::vector<Lattice*>& dfInfo, bool fw);
+
+        // Meets the caller's dataflow state at a call site into the state before the callee, without scheduling anything.
+        // Returns true if the callee's state was modified.
+        bool meetIntoCallee(const Function& callee, SgFunctionCallExp* call, const std::vector<Lattice*>& dfInfo, bool fw);
+
+        // Returns a copy of a caller's lattice at the given call site, remapped for the callee's variables
+        static Lattice* remapToCallee(const Lattice* callerL, SgFunctionCallExp* call, const Function& callee);
+};
+
+// Computes the same context-insensitive inter-procedural dataflow as ContextInsensitiveInterProceduralDataflow but
+// schedules the work by the strongly connected components (SCCs) of the call graph so that it can use multiple threads.
+//
+// The SCCs are processed bottom-up: each SCC is assigned a level one higher than the highest level of the SCCs it calls,
+// and the SCCs of a level, which cannot call one another, are analyzed concurrently. Each SCC is iterated to a local
+// fixpoint by a single thread. Its callers are re-analyzed only when the dataflow state at the exit of one of its functions
+// changes, starting at the calls to that function. State that a caller propagates into a callee in a different SCC is
+// recorded and merged into the callee after the level is finished, in a fixed order, so the results do not depend on the
+// number of threads or on how the SCCs were distributed among them. The levels are swept repeatedly until no function
+// needs to be re-analyzed.
+//
+// With more than one thread the intra-procedural analysis (its transfer functions and lattices) must be safe to run on
+// different functions concurrently; the functions' initial states are generated before any threads start. Since the Dbg
+// output stream is not thread safe, only one thread is used when analysisDebugLevel is non-zero.
+class ParallelContextInsensitiveInterProceduralDataflow : public ContextInsensitiveInterProceduralDataflow
+{
+        public:
+        // nThreads - maximum number of threads used to analyze the SCCs of a level; 0 means one per hardware thread.
+        ParallelContextInsensitiveInterProceduralDataflow(IntraProceduralDataflow* intraDataflowAnalysis,
+                                                          SgIncidenceDirectedGraph* graph, size_t nThreads = 0);
+
+        // Analyzes all the functions in the call graph until their dataflow states reach a fixpoint.
+        void runAnalysis();
+
+        protected:
+        bool propagateToCallee(const Function& caller, const Function& callee, SgFunctionCallExp* call,
+                               const std::vector<Lattice*>& dfInfo, bool fw);
+
+        private:
+        // Dataflow state propagated from a call site into a callee in another SCC, not yet merged into the callee
+        struct CalleeUpdate
+        {
+                Function callee;
+                SgFunctionCallExp* call;
+                std::vector<Lattice*> lattices; // copies of the caller's lattices at the call
+                bool fw;
+        };
+
+        // A strongly connected component of the call graph
+        struct Component
+        {
+                std::vector<size_t> members;          // indexes of its functions, in increasing order
+                size_t level;
+                std::list<size_t> worklist;           // its functions that remain to be analyzed in the current pass
+                std::vector<size_t> modified;         // its functions whose exit state changed in the current pass
+                std::vector<CalleeUpdate> deferred;   // updates to callees in other SCCs, in the order they were made
+        };
+
+        class WorkQueues;
+
+        // Computes the SCCs of the call graph and their levels
+        void computeComponents();
+
+        // Analyzes the functions of an SCC until none of them needs to be re-analyzed
+        void analyzeComponent(size_t component);
+
+        // Analyzes the SCCs that queue gives to the given worker until it runs out of them
+        void processComponents(WorkQueues* queues, size_t worker);
+
+        // Merges the results of the given SCCs into the state of the functions outside of them
+        void finishComponents(const std::vector<size_t>& components);
+
+        size_t nThreads;
+
+        // True while the SCCs are being analyzed; propagateToCallee() then defers updates to other SCCs
+        bool scheduling;
+
+        // All the functions in the call graph, in the order of TraverseCallGraph::functions, and their indexes
+        std::vector<const CGFunction*> funcs;
+        std::map<Function, size_t> funcIndex;
+        std::vector<std::vector<size_t> > calleesOf, callersOf;
+
+        std::vector<Component> components;    // callees come before their callers
+        std::vector<size_t> componentOf;      // the SCC of each function
+        std::vector<std::vector<size_t> > levels;
+
+        // Per function: whether it must be analyzed, whether the state at its entry changed, whether it has been analyzed
+        // by runAnalysis() yet and which of its callees' exit states changed
+        std::vector<char> pending, dueToCallers, analyzed;
+        std::vector<std::set<Function> > calleesUpdated;
 };
 
 #endif
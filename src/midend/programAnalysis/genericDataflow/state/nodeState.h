@@ -86,6 +86,16 @@ class NodeStateHashCompare
 };
 #endif
 
+// Without THREADED, the state of all analyses is kept in dense storage instead of per-node maps. Every analysis
+// gets a slot number (see registerAnalysis()), and the NodeStates of all the CFG nodes of a function share one
+// Storage object in which each analysis has a contiguous array holding its state at every node of the function.
+// Looking up an analysis' state at a node is therefore two vector indexing operations, and an analysis that
+// iterates over a function touches consecutive memory rather than one map per node.
+//
+// When setLattices() initializes a node, the below lattices are not copied from the above lattices right away;
+// the copy is made the first time the analysis' state at that node is accessed. Since lattices are handed out as
+// mutable pointers, this is the extent of the sharing: nodes that are initialized but never visited (e.g.,
+// unreachable code) never pay for the copies.
 class NodeState
 {
         #ifdef THREADED
@@ -93,12 +103,6 @@ class NodeState
         //typedef tbb::concurrent_hash_map <Analysis*, map <int, NodeFact*>, NodeStateHashCompare > NodeFactMap;
         typedef tbb::concurrent_hash_map <Analysis*, std::vector<NodeFact*>, NodeStateHashCompare > NodeFactMap;
         typedef tbb::concurrent_hash_map <Analysis*, bool, NodeStateHashCompare  > BoolMap;     
-        #else
-        typedef std::map<Analysis*, std::vector<Lattice*> > LatticeMap;
-        //typedef std::map<Analysis*, std::map<int, NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, std::vector<NodeFact*> > NodeFactMap;
-        typedef std::map<Analysis*, bool > BoolMap;
-        #endif
         
         // the dataflow information Above the node, for each analysis that 
         // may be interested in the current node
@@ -115,6 +119,60 @@ class NodeState
         // Contains all the Analyses that have initialized their state at this node. It is a map because
         // TBB doesn't provide a concurrent set.
         BoolMap initializedAnalyses;
+        #else
+        // The state of one analysis at one node
+        struct AnalysisState
+        {
+                // the dataflow information above and below the node
+                std::vector<Lattice*> above;
+                std::vector<Lattice*> below;
+                // the facts that are true at this node
+                std::vector<NodeFact*> facts;
+                // true if the analysis has initialized its state at this node
+                bool initialized;
+                // true if below has not yet been made a copy of above (see setLattices())
+                bool belowSharesAbove;
+                
+                AnalysisState() : initialized(false), belowSharesAbove(false) {}
+        };
+        
+        // The states of a group of NodeStates: slots[s][p] is the state of the analysis with slot s at the
+        // NodeState at position p of the group. The array of a slot is allocated when the analysis first stores
+        // state in the group, or is NULL until then. The arrays are never reallocated, so the lattice vectors
+        // handed out by getLatticeAbove/Below stay valid when other analyses add their slots.
+        struct Storage
+        {
+                size_t numStates;
+                std::vector<AnalysisState*> slots;
+                
+                Storage(size_t numStates) : numStates(numStates) {}
+                ~Storage();
+                
+                // returns the array of a slot, allocating it if necessary
+                AnalysisState* slotArray(size_t slot);
+                
+                private:
+                Storage(const Storage&);
+                Storage& operator=(const Storage&);
+        };
+        
+        // the storage holding this NodeState's data, and this NodeState's position in it
+        Storage* storage;
+        size_t position;
+        
+        // true if the storage belongs to this NodeState alone and is freed with it
+        bool ownsStorage;
+        
+        // creates a NodeState whose data is at the given position of a shared storage
+        NodeState(Storage* storage, size_t position) : storage(storage), position(position), ownsStorage(false)
+        {}
+        
+        // returns the state of the given analysis at this node, or NULL if the analysis has never stored
+        // state here and create is false. If copyBelow is true and the below lattices are still shared
+        // with the above lattices, they are copied first; this must be done before the caller accesses
+        // either set of lattices.
+        AnalysisState* getState(const Analysis* analysis, bool create, bool copyBelow=true) const;
+        #endif
         
         // the dataflow node that this NodeState object corresponds to
         //DataflowNode parentNode;
@@ -129,8 +187,19 @@ class NodeState
         NodeState(CFGNode parentNode) : parentNode(parentNode)
         {}*/
         
+        #ifdef THREADED
         NodeState()
         {}
+        #else
+        NodeState() : storage(new Storage(1)), position(0), ownsStorage(true)
+        {}
+        
+        // copies the lattice and fact pointers of all analyses (not the pointed-to objects)
+        NodeState(const NodeState& that);
+        NodeState& operator=(const NodeState& that);
+        
+        ~NodeState();
+        #endif
         
 /*      void initialize(Analysis* analysis, int latticeName)
         {
@@ -168,6 +237,12 @@ class NodeState
         }*/
         
         public:
+        // Assigns the analysis its slot in the dense NodeState storage and returns it. Analyses are
+        // registered the first time they store state at a node, so calling this is only required when
+        // state will be stored from multiple threads: registration itself is not thread safe. An analysis
+        // keeps its slot for the rest of the run.
+        static int registerAnalysis(const Analysis* analysis);
+        
         // Records that this analysis has initializedAnalyses its state at this node
         void initialized(Analysis* analysis);
         
@@ -239,9 +314,11 @@ class NodeState
         void addLattice_ex(std::map<Analysis*, std::vector<Lattice*> >& dfMap, 
                           const  Analysis* analysis, int latticeName, Lattice* l);
         */
+        #ifdef THREADED
         // returns the given lattice, which owned by the given analysis
         Lattice* getLattice_ex(const LatticeMap& dfMap, 
                           const Analysis* analysis, int latticeName) const;
+        #endif
         
         /*// removes the given lattice, owned by the given analysis
         // returns true if the given lattice was found and removed and false if it was not found
@@ -17,6 +17,7 @@
 #include <fstream>
 #include <sstream>
 #include <boost/foreach.hpp>
+#include <boost/function.hpp>
 #include <filteredCFG.h>
 #include <boost/unordered_map.hpp>
 #include "reachingDef.h"
@@ -143,8 +144,12 @@ public:
     /** Run the analysis. If interprocedural analysis is not enabled, functionc all expressions (SgFunctionCallExp) will not
      * count as definitions of any variables.
      * @param interprocedural true to enable interprocedural analysis, false to perform no interprocedural analysis. 
-     * @param treatPointersAsStructures if true, p->x is versioned as if it were the variable p.x. */
-    void run(bool interprocedural, bool treatPointersAsStructures);
+     * @param treatPointersAsStructures if true, p->x is versioned as if it were the variable p.x.
+     * @param nThreads number of threads used for the per-function parts of the analysis (local defs and uses before the
+     *                 interprocedural pass, phi functions and reaching definitions after it), or zero for one per hardware
+     *                 thread. The interprocedural pass always runs serially, as do functions that are nested inside other
+     *                 analyzed functions. The results are the same as with one thread. */
+    void run(bool interprocedural, bool treatPointersAsStructures, size_t nThreads = 1);
 
     static bool getDebug()
     {
@@ -157,6 +162,32 @@ public:
     }
 
 private:
+    /** One per-function part of the analysis, applied to the analysis object that holds the function's tables. */
+    typedef boost::function<void(StaticSingleAssignment*, SgFunctionDefinition*)> FunctionPhase;
+
+    /** Work list and results shared by the threads of runPhaseInParallel. */
+    struct ParallelPhaseState;
+
+    /** Collect the local (not propagated) defs and uses of a function, including expanded member defs and uses. */
+    void collectLocalDefsAndUses(SgFunctionDefinition* func, bool treatPointersAsStructures);
+
+    /** Insert phi functions, propagate reaching definitions along the CFG of a function, and build its use table. */
+    void computeReachingDefs(SgFunctionDefinition* func);
+
+    /** Run a per-function phase on independent functions using several threads. Each function is analyzed in a private
+     * analysis object whose tables are merged into this object afterward, in the order of @p functions. The functions must
+     * not be nested in one another, so that no two of them touch the same table entries. */
+    void runPhaseInParallel(const std::vector<SgFunctionDefinition*>& functions, const FunctionPhase& phase, size_t nThreads);
+
+    /** Body of each thread started by runPhaseInParallel. */
+    void runPhaseWorker(ParallelPhaseState* state);
+
+    /** Copy the local def and use entries for the nodes of a function from another analysis object. */
+    void copyLocalTablesForFunction(const StaticSingleAssignment& from, SgFunctionDefinition* func);
+
+    /** Copy all table entries from another analysis object, replacing entries for the same nodes. */
+    void mergeTables(const StaticSingleAssignment& from);
+
     /** Once all the local definitions have been inserted in the ssaLocalDefsTable and phi functions have been inserted
      * in the reaching defs table, propagate reaching definitions along the CFG. */
     void runDefUseDataFlow(SgFunctionDefinition* func);
@@ -41,6 +41,7 @@ namespace ELF{
 // added here to avoid placing it in each header file using the AstProcessingLib
 #include <typeinfo>
 #include "AstProcessing.h"
+#include "AstAttributeTable.h"
 #include "AstReverseProcessing.h"
 #include "AstPDFGeneration.h"
 #include "AstDOTGeneration.h"
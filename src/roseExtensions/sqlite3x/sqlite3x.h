@@ -124,6 +124,9 @@ namespace sqlite3x {
                 sqlite3_command(sqlite3_connection &con, const std::wstring &sql);
                 ~sqlite3_command();
 
+                /** Number of parameters ("?", etc.) in the prepared SQL. */
+                int bind_parameter_count() const;
+
                 // WARNING: 'index' is 1-origin!!                               [Robb P. Matzke 2013-03-18]
                 void bind(int index);
                 void bind(int index, int data);
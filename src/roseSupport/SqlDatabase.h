@@ -134,6 +134,8 @@ class Transaction;
 class TransactionImpl;
 class Statement;
 class StatementImpl;
+class BulkInserter;
+class BulkInserterImpl;
 
 /** Smart pointer to a database connection.  Database connections are always referenced through their smart pointers and are
  *  automatically deleted when all references disappear. See Connection::create(). */
@@ -185,12 +187,18 @@ private:
  *  transactions in which statements are executed.  The connection is automatically closed once all references to it have
  *  disappeared (both user references and references from transactions).
  *
+ *  A connection is also a pool of low-level driver connections: each transaction uses one low-level connection that is not
+ *  used by any other unterminated transaction, and low-level connections are reused by later transactions when the driver
+ *  permits it.  Therefore a single connection can be shared by many threads provided that each thread uses its own
+ *  transactions (and their statements); transactions and statements themselves are not thread safe.
+ *
  *  Connections should be closed around fork().  Most low-level drivers don't gracefully handle this situation. (FIXME: we
  *  might be able to work around this to some extent in the SqlDatabase implementation. [Robb P. Matzke 2013-05-31] */
 class Connection: public boost::enable_shared_from_this<Connection> {
     friend class TransactionImpl;
     friend class Transaction;
     friend class StatementImpl;
+    friend class BulkInserterImpl;
 public:
     /** Create a new database connection.  All connection objects are bound to a database throughout their lifetime, although
      * depending on the driver, the actual low-level connection may open and close. The @p open_spec string describes how to
@@ -227,6 +235,27 @@ public:
     FILE *get_debug() const;
     /** @} */
 
+    /** Prepared statement cache size.  For drivers that support it (currently SQLite3), a statement is compiled once and
+     *  executed many times with different bound values, and when a Statement object is destroyed its compiled form is kept
+     *  by the connection so that a later statement with the same SQL text need not be compiled again.  This property limits
+     *  the number of idle compiled statements kept for each low-level connection; zero disables the cache.  The default is
+     *  64.
+     * @{ */
+    void set_statement_cache_size(size_t n);
+    size_t get_statement_cache_size() const;
+    /** @} */
+
+    /** Prepared statement cache statistics.  These are the number of times a statement was found in the cache, and the
+     *  number of times a statement had to be compiled.
+     * @{ */
+    size_t statement_cache_hits() const;
+    size_t statement_cache_misses() const;
+    /** @} */
+
+    /** Number of low-level driver connections.  This is the largest number of transactions that have been simultaneously
+     *  active on this connection (for drivers that reuse low-level connections). */
+    size_t nconnections() const;
+
     /** Print some basic info about this connection. */
     void print(std::ostream&) const;
 
@@ -259,6 +288,7 @@ class Transaction: public boost::enable_shared_from_this<Transaction> {
     friend class ConnectionImpl;
     friend class Statement;
     friend class StatementImpl;
+    friend class BulkInserterImpl;
 public:
     /** Create a new transaction.  Transactions can be created either by this class method or by calling
      *  Connection::transaction().  The transaction will exist until there are no references (user or statements).
@@ -289,8 +319,9 @@ public:
 
     /** Bulk load data into table.  The specified input stream contains comma-separated values which are inserted in bulk
      *  into the specified table.  The number of fields in each row of the input stream must match the number of columns
-     *  in the table. Some drivers require that a bulk load is the only operation performed in a transaction. */
-    void bulk_load(const std::string &tablename, std::istream&);
+     *  in the table. Some drivers require that a bulk load is the only operation performed in a transaction. Returns the
+     *  number of rows inserted.  See also, BulkInserter. */
+    size_t bulk_load(const std::string &tablename, std::istream&);
 
     /** Returns the low-level driver name for this transaction. */
     Driver driver() const;
@@ -439,6 +470,68 @@ template<> float Statement::iterator::get<float>(size_t idx);
 template<> double Statement::iterator::get<double>(size_t idx);
 template<> std::string Statement::iterator::get<std::string>(size_t idx);
     
+/*******************************************************************************************************************************
+ *                                      Bulk inserts
+ *******************************************************************************************************************************/
+
+/** Inserts many rows into one table.  Inserting rows one at a time with an "insert" statement costs a round trip to the
+ *  database for each row.  A bulk inserter instead accumulates rows in memory and writes them in batches, using the most
+ *  efficient mechanism provided by the driver: multi-row "insert" statements that are compiled once and reused for SQLite3,
+ *  and "copy" for PostgreSQL.  The table's other columns get their default values.
+ *
+ *  Values are bound to columns with bind(), which uses zero-origin indices into the column list given to the constructor.
+ *  Once all columns of a row are bound, insert() adds the row to the batch; the batch is written automatically when it
+ *  reaches the batch size.  The user must call flush() to write the final rows; rows that are not flushed when the inserter
+ *  is destroyed are discarded.
+ *
+ *  @code
+ *      SqlDatabase::BulkInserter ins(tx, "semantic_instructions", columns);
+ *      for (...)
+ *          ins.bind(0, address).bind(1, size).bind(2, func_id).insert();
+ *      ins.flush();
+ *  @endcode
+ *
+ *  Some drivers require that nothing else is executed in the transaction while a batch is being written, which is only
+ *  during insert() and flush(). */
+class BulkInserter {
+public:
+    /** Create an inserter for the specified columns of a table. */
+    BulkInserter(const TransactionPtr &tx, const std::string &tablename, const std::vector<std::string> &columns,
+                 size_t batch_size=1000);
+
+    /** Create an inserter for all columns of a table, in the order they were declared. */
+    BulkInserter(const TransactionPtr &tx, const std::string &tablename, size_t ncolumns, size_t batch_size=1000);
+
+    ~BulkInserter();
+
+    /** Bind a value to a column of the current row.  Returns this inserter so calls can be chained.
+     * @{ */
+    BulkInserter& bind(size_t column, int32_t val);
+    BulkInserter& bind(size_t column, int64_t val);
+    BulkInserter& bind(size_t column, uint32_t val);
+    BulkInserter& bind(size_t column, uint64_t val);
+    BulkInserter& bind(size_t column, double val);
+    BulkInserter& bind(size_t column, const std::string &val);
+    /** @} */
+
+    /** Add the current row to the batch.  All columns must be bound.  The next row starts with no columns bound. */
+    void insert();
+
+    /** Write all pending rows to the database. */
+    void flush();
+
+    /** Number of rows waiting to be written. */
+    size_t npending() const;
+
+    /** Number of rows written so far. */
+    size_t ninserted() const;
+
+private:
+    BulkInserter(const BulkInserter&);                  // not copyable
+    BulkInserter& operator=(const BulkInserter&);
+    BulkInserterImpl *impl;
+};
+
 /*******************************************************************************************************************************
  *                                      Miscellaneous functions
  *******************************************************************************************************************************/
@@ -96,6 +96,7 @@ enum RTS_Layer {
     RTS_LAYER_ROSE_CALLBACKS_LIST_OBJ   = 100,          /**< ROSE_Callbacks::List class */
     RTS_LAYER_RTS_MESSAGE_CLASS         = 105,          /**< RTS_Message class */
     RTS_LAYER_DISASSEMBLER_CLASS        = 110,          /**< Disassembler class */
+    RTS_LAYER_ROSE_INSN_SEMANTICS_EXPR  = 114,          /**< InsnSemanticsExpr intern table id counter */
     RTS_LAYER_ROSE_SMT_SOLVERS          = 115,          /**< SMTSolver class */
 
     /* Simulator layers (see projects/simulator), 200-220
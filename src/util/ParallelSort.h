@@ -1,8 +1,14 @@
-// Parallel sorting using multiple threads. See ParallelSort::quicksort() near the end of this file.
+// Parallel sorting using multiple threads. See ParallelSort::quicksort() and ParallelSort::mergesort() near the end of this file.
 #ifndef ROSE_ParallelSort_H
 #define ROSE_ParallelSort_H
 
+#include <algorithm>
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
 #include <boost/thread.hpp>
+#include <cassert>
+#include <deque>
+#include <iterator>
 #include <list>
 #include <vector>
 
@@ -15,31 +21,177 @@ namespace rose {
  *  algorithms are implemented:
  *
  *  <ul>
- *   <li>quicksort()</li>
+ *   <li>quicksort() is a work-stealing quicksort and is not stable (like std::sort).</li>
+ *   <li>mergesort() sorts blocks of values in parallel and then merges them in parallel.  It is stable (like
+ *       std::stable_sort) but needs temporary storage.</li>
  *  </ul>
- */
+ *
+ *  The threads come from a pool that is shared by all calls and which grows to the largest number of threads requested.
+ *  The calling thread always participates in the sort, so a sort makes progress even when the pool's threads are busy with
+ *  other work (including other sorts). */
 namespace ParallelSort {
 
 // This stuff is all private but useful for any parallel sort algorithm.
 namespace Private {
 
+// Threads shared by all parallel sorts.  A task is tagged with the group that submitted it so that the group can withdraw
+// tasks that haven't started yet.  Threads are created on demand and live until the program exits.
+class ThreadPool {
+    struct Task {
+        const void *tag;
+        boost::function<void()> function;
+        Task(const void *tag, const boost::function<void()> &function): tag(tag), function(function) {}
+    };
+
+    boost::mutex mutex_;                                // protects all following data members
+    boost::condition_variable taskInsertion_;           // signaled when a task is added
+    std::list<Task> tasks_;                             // tasks that haven't started yet
+    boost::thread_group threads_;
+    size_t nThreads_;
+
+    ThreadPool(): nThreads_(0) {}
+
+    void worker() {
+        while (true) {
+            boost::function<void()> function;
+            {
+                boost::unique_lock<boost::mutex> lock(mutex_);
+                while (tasks_.empty())
+                    taskInsertion_.wait(lock);
+                function = tasks_.front().function;
+                tasks_.pop_front();
+            }
+            function();
+        }
+    }
+
+public:
+    // The pool shared by all sorts. It is never destroyed since its threads never exit.
+    static ThreadPool& instance() {
+        static boost::mutex creation;
+        static ThreadPool *pool = NULL;
+        boost::lock_guard<boost::mutex> lock(creation);
+        if (!pool)
+            pool = new ThreadPool;
+        return *pool;
+    }
+
+    // Make sure the pool has at least @p n threads.
+    void reserve(size_t n) {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        while (nThreads_ < n) {
+            threads_.create_thread(boost::bind(&ThreadPool::worker, this));
+            ++nThreads_;
+        }
+    }
+
+    size_t nThreads() {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        return nThreads_;
+    }
+
+    void submit(const void *tag, const boost::function<void()> &function) {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        tasks_.push_back(Task(tag, function));
+        taskInsertion_.notify_one();
+    }
+
+    // Remove tasks that haven't started yet and return how many were removed.
+    size_t cancel(const void *tag) {
+        boost::lock_guard<boost::mutex> lock(mutex_);
+        size_t n = 0;
+        for (std::list<Task>::iterator ti=tasks_.begin(); ti!=tasks_.end(); /*void*/) {
+            if (ti->tag == tag) {
+                ti = tasks_.erase(ti);
+                ++n;
+            } else {
+                ++ti;
+            }
+        }
+        return n;
+    }
+};
+
+// Runs a functor on the calling thread and on up to nthreads-1 pool threads.  The functor must be safe to run concurrently
+// and must return once there is no more work for it; since pool threads might start late (or not at all) it must also
+// work correctly no matter how many threads run it.  The run() method returns after every copy that started has finished.
+class TaskGroup {
+    boost::mutex mutex_;
+    boost::condition_variable finished_;
+    size_t nSubmitted_, nFinished_;
+
+    struct Helper {
+        TaskGroup *group;
+        boost::function<void()> function;
+        Helper(TaskGroup *group, const boost::function<void()> &function): group(group), function(function) {}
+        void operator()() {
+            function();
+            boost::lock_guard<boost::mutex> lock(group->mutex_);
+            ++group->nFinished_;
+            group->finished_.notify_all();
+        }
+    };
+
+public:
+    TaskGroup(): nSubmitted_(0), nFinished_(0) {}
+
+    void run(const boost::function<void()> &function, size_t nthreads) {
+        size_t nhelpers = std::max(nthreads, (size_t)1) - 1;
+        if (nhelpers > 0) {
+            ThreadPool &pool = ThreadPool::instance();
+            pool.reserve(nhelpers);
+            nSubmitted_ = nhelpers;
+            for (size_t i=0; i<nhelpers; ++i)
+                pool.submit(this, Helper(this, function));
+        }
+
+        function();                                     // participate ourselves (we might be the only thread!)
+
+        if (nhelpers > 0) {
+            size_t ncancelled = ThreadPool::instance().cancel(this);
+            boost::unique_lock<boost::mutex> lock(mutex_);
+            while (nFinished_ + ncancelled < nSubmitted_)
+                finished_.wait(lock);
+        }
+    }
+};
+
 // A unit of work.  The values to be worked on are specified by a begin (inclusive) and end (exclusive) iterator.
 template<class RandomAccessIterator>
 struct Work {
     RandomAccessIterator begin, end;
+    Work() {}
     Work(RandomAccessIterator begin, RandomAccessIterator end): begin(begin), end(end) {}
 };
 
+// Work that a thread has produced but not yet started. The owner pushes and pops at the back (depth first) and other threads
+// steal from the front, where the largest ranges are.
+template<class RandomAccessIterator>
+struct WorkDeque {
+    boost::mutex mutex;
+    std::deque<Work<RandomAccessIterator> > works;
+};
+
 // Information about a sorting job.  A job is generated when the user requests a sort, and each job may have multiple threads.
 template<class RandomAccessIterator, class Compare>
 struct Job {
     Compare compare;                                    // functor to compare two values, like for std::sort()
-    boost::condition_variable worklistInsertion;        // signaled when something is added to the worklist
-    static const int multiThreshold = 10000;            // size at which to start multi-threading
-    boost::mutex mutex;                                 // protects all of the following data members
-    std::list<Work<RandomAccessIterator> > worklist;    // non-overlapping stuff that needs to be sorted
-    size_t npending;                                    // number of workers that are processing jobs that aren't in worklist
-    Job(Compare compare): compare(compare), npending(0) {}
+    size_t multiThreshold;                              // size at which to start multi-threading
+    std::vector<WorkDeque<RandomAccessIterator>*> deques; // one per participating thread
+    boost::mutex mutex;                                 // protects the following data members
+    size_t npending;                                    // number of work units queued or being sorted
+    size_t nparticipants;                               // number of threads that have joined this job
+
+    Job(Compare compare, size_t nthreads, size_t multiThreshold)
+        : compare(compare), multiThreshold(multiThreshold), npending(0), nparticipants(0) {
+        for (size_t i=0; i<nthreads; ++i)
+            deques.push_back(new WorkDeque<RandomAccessIterator>);
+    }
+
+    ~Job() {
+        for (size_t i=0; i<deques.size(); ++i)
+            delete deques[i];
+    }
 };
 
 // Somewhat like std::partition(). Partitions the iterator range into two parts according to the value at the pivot iterator
@@ -60,61 +212,197 @@ RandomAccessIterator partition(RandomAccessIterator begin, RandomAccessIterator
     return pivot;
 }
 
-// Add work to the work list
+// Returns whichever of the three iterators points to the median value.
+template<class RandomAccessIterator, class Compare>
+RandomAccessIterator medianOfThree(RandomAccessIterator a, RandomAccessIterator b, RandomAccessIterator c, Compare compare) {
+    if (compare(*a, *b)) {
+        if (compare(*b, *c))
+            return b;
+        return compare(*a, *c) ? c : a;
+    }
+    if (compare(*a, *c))
+        return a;
+    return compare(*b, *c) ? c : b;
+}
+
+// Predicate that's true for values not greater than the pivot value.
+template<class RandomAccessIterator, class Compare>
+struct NotGreater {
+    RandomAccessIterator pivot;
+    Compare compare;
+    NotGreater(RandomAccessIterator pivot, Compare compare): pivot(pivot), compare(compare) {}
+    template<class T>
+    bool operator()(const T &value) { return !compare(*pivot, value); }
+};
+
+// Add work to a thread's deque
+template<class RandomAccessIterator, class Compare>
+void addWork(Job<RandomAccessIterator, Compare> &job, size_t id, const Work<RandomAccessIterator> &work) {
+    {
+        boost::lock_guard<boost::mutex> lock(job.mutex);
+        ++job.npending;
+    }
+    boost::lock_guard<boost::mutex> lock(job.deques[id]->mutex);
+    job.deques[id]->works.push_back(work);
+}
+
+// Get work from our own deque, or steal some from another thread.  Returns false if no work was found.
 template<class RandomAccessIterator, class Compare>
-void addWork(Job<RandomAccessIterator, Compare> &job, const Work<RandomAccessIterator> &work) {
-    boost::lock_guard<boost::mutex> lock(job.mutex);
-    job.worklist.push_back(work);
-    job.worklistInsertion.notify_one();
+bool takeWork(Job<RandomAccessIterator, Compare> &job, size_t id, Work<RandomAccessIterator> &work /*out*/) {
+    {
+        WorkDeque<RandomAccessIterator> &own = *job.deques[id];
+        boost::lock_guard<boost::mutex> lock(own.mutex);
+        if (!own.works.empty()) {
+            work = own.works.back();
+            own.works.pop_back();
+            return true;
+        }
+    }
+    for (size_t i=1; i<job.deques.size(); ++i) {
+        WorkDeque<RandomAccessIterator> &victim = *job.deques[(id+i) % job.deques.size()];
+        boost::lock_guard<boost::mutex> lock(victim.mutex);
+        if (!victim.works.empty()) {
+            work = victim.works.front();
+            victim.works.pop_front();
+            return true;
+        }
+    }
+    return false;
 }
 
 // Sorts one unit of work, adding additional items to the worklist if necessary.
 template<class RandomAccessIterator, class Compare>
-void quicksort(Job<RandomAccessIterator, Compare> &job, Work<RandomAccessIterator> work) {
+void quicksort(Job<RandomAccessIterator, Compare> &job, size_t id, Work<RandomAccessIterator> work) {
     while (work.end - work.begin > 1) {
-        if (work.end - work.begin < job.multiThreshold) {
+        if ((size_t)(work.end - work.begin) < job.multiThreshold) {
             std::sort(work.begin, work.end, job.compare);
             return;
         } else {
-            RandomAccessIterator pivot = work.begin + (work.end - work.begin) / 2; // assuming fairly even distribution
+            RandomAccessIterator pivot = medianOfThree(work.begin, work.begin + (work.end - work.begin) / 2, work.end - 1,
+                                                       job.compare);
             pivot = partition(work.begin, work.end, pivot, job.compare);
-            addWork(job, Work<RandomAccessIterator>(pivot+1, work.end));
-            work.end = pivot;
+
+            // Values equal to the pivot all end up in the second part, so many duplicates would make the split lopsided.
+            // Move the values equal to the pivot next to it since they're already in their final position.
+            RandomAccessIterator secondBegin = pivot + 1;
+            if ((pivot - work.begin) < (work.end - work.begin) / 8)
+                secondBegin = std::partition(secondBegin, work.end, NotGreater<RandomAccessIterator, Compare>(pivot, job.compare));
+
+            // Give away the larger part and keep sorting the smaller part ourselves.
+            if (pivot - work.begin < work.end - secondBegin) {
+                addWork(job, id, Work<RandomAccessIterator>(secondBegin, work.end));
+                work.end = pivot;
+            } else {
+                addWork(job, id, Work<RandomAccessIterator>(work.begin, pivot));
+                work.begin = secondBegin;
+            }
         }
     }
 }
 
-// A worker thread.
+// A thread participating in a quicksort job.
 template<class RandomAccessIterator, class Compare>
 struct Worker {
     Job<RandomAccessIterator, Compare> &job;
-    size_t id;                                          // only for debugging
-    Worker(Job<RandomAccessIterator, Compare> &job, size_t id): job(job), id(id) {}
+    Worker(Job<RandomAccessIterator, Compare> &job): job(job) {}
     void operator()() {
-        boost::unique_lock<boost::mutex> lock(job.mutex);
+        size_t id;
+        {
+            boost::lock_guard<boost::mutex> lock(job.mutex);
+            id = job.nparticipants++;
+        }
+        assert(id < job.deques.size());
+
         while (true) {
-            // Get the next unit of work. If no workers are working and the worklist is empty then we're all done.
-            while (job.worklist.empty() && job.npending>0)
-                job.worklistInsertion.wait(lock);
-            if (job.worklist.empty())
-                return;
-            Work<RandomAccessIterator> work = job.worklist.front();
-            job.worklist.pop_front();
-            ++job.npending;
+            // Get the next unit of work. If no work is queued or being sorted then we're all done.
+            Work<RandomAccessIterator> work;
+            if (!takeWork(job, id, work)) {
+                {
+                    boost::lock_guard<boost::mutex> lock(job.mutex);
+                    if (0==job.npending)
+                        return;
+                }
+                boost::this_thread::yield();            // other threads are still producing work
+                continue;
+            }
 
             // Sort that unit of work
-            lock.unlock();
-            quicksort(job, work);
-            lock.lock();
+            quicksort(job, id, work);
 
             // Indicate that the work is completed
+            boost::lock_guard<boost::mutex> lock(job.mutex);
             assert(job.npending>0);
-            if (0==--job.npending && job.worklist.empty())
-                job.worklistInsertion.notify_all();
+            --job.npending;
         }
     }
 };
 
+// A thread participating in one phase of a merge sort.  The phase consists of ntasks independent tasks numbered from zero.
+template<class Task>
+struct PhaseWorker {
+    Task task;
+    size_t ntasks;
+    boost::mutex &mutex;                                // protects nextTask
+    size_t &nextTask;
+    PhaseWorker(const Task &task, size_t ntasks, boost::mutex &mutex, size_t &nextTask)
+        : task(task), ntasks(ntasks), mutex(mutex), nextTask(nextTask) {}
+    void operator()() {
+        while (true) {
+            size_t i;
+            {
+                boost::lock_guard<boost::mutex> lock(mutex);
+                if (nextTask >= ntasks)
+                    return;
+                i = nextTask++;
+            }
+            task(i);
+        }
+    }
+};
+
+// Run ntasks tasks using up to nthreads threads and return when they've all finished.
+template<class Task>
+void runPhase(const Task &task, size_t ntasks, size_t nthreads) {
+    boost::mutex mutex;
+    size_t nextTask = 0;
+    TaskGroup group;
+    group.run(PhaseWorker<Task>(task, ntasks, mutex, nextTask), std::min(nthreads, ntasks));
+}
+
+// Stable-sorts block i of a merge sort.
+template<class RandomAccessIterator, class Compare>
+struct SortBlock {
+    RandomAccessIterator begin, end;
+    size_t blockSize;
+    Compare compare;
+    SortBlock(RandomAccessIterator begin, RandomAccessIterator end, size_t blockSize, Compare compare)
+        : begin(begin), end(end), blockSize(blockSize), compare(compare) {}
+    void operator()(size_t i) {
+        RandomAccessIterator lo = begin + i * blockSize;
+        RandomAccessIterator hi = (size_t)(end - lo) > blockSize ? lo + blockSize : end;
+        std::stable_sort(lo, hi, compare);
+    }
+};
+
+// Merges the sorted runs [2i*runSize, (2i+1)*runSize) and [(2i+1)*runSize, (2i+2)*runSize) of the source into the
+// destination.  Values from the first run come first when they compare equal, which keeps the sort stable.
+template<class InputIterator, class OutputIterator, class Compare>
+struct MergeRuns {
+    InputIterator begin, end;
+    OutputIterator output;
+    size_t runSize;
+    Compare compare;
+    MergeRuns(InputIterator begin, InputIterator end, OutputIterator output, size_t runSize, Compare compare)
+        : begin(begin), end(end), output(output), runSize(runSize), compare(compare) {}
+    void operator()(size_t i) {
+        size_t n = end - begin;
+        size_t lo = std::min(2 * i * runSize, n);
+        size_t mid = std::min(lo + runSize, n);
+        size_t hi = std::min(mid + runSize, n);
+        std::merge(begin+lo, begin+mid, begin+mid, begin+hi, output+lo, compare);
+    }
+};
+
 } // namespace
 
 
@@ -122,6 +410,9 @@ struct Worker {
  *  @p compare using @p nthreads threads.  Multi-threading is only used if the size of the range of values exceeds a certain
  *  threshold.
  *
+ *  Each thread partitions ranges of values and keeps sorting one part while making the other part available to the other
+ *  threads, which steal it when they run out of work. Like std::sort, this sort is not stable.
+ *
  *  Note: using normal C++ iterators with debugging support will result in slower execution the more threads are used because
  *  the iterator dereference operators serialize some sanity checks which causes lock contention.  It is best to do the sanity
  *  check once up front, then then call the sort function with pointers.  For example:
@@ -138,26 +429,72 @@ struct Worker {
  */
 template<class RandomAccessIterator, class Compare>
 void quicksort(RandomAccessIterator begin, RandomAccessIterator end, Compare compare, size_t nthreads) {
-    assert(begin < end);
+    assert(begin <= end);
+    using namespace Private;
+    static const size_t minMultiThreshold = 10000;      // smaller ranges are not worth handing to another thread
+    size_t nvalues = end - begin;
+    nthreads = std::max(nthreads, (size_t)1);
+    if (nvalues < 2)
+        return;
+    if (1==nthreads || nvalues < minMultiThreshold) {
+        std::sort(begin, end, compare);
+        return;
+    }
+
+    // Aim for a few dozen ranges per thread so that stealing can balance the load.
+    size_t multiThreshold = std::max(minMultiThreshold, nvalues / (32 * nthreads));
+    Job<RandomAccessIterator, Compare> job(compare, nthreads, multiThreshold);
+    addWork(job, 0, Work<RandomAccessIterator>(begin, end));
+    TaskGroup group;
+    group.run(Worker<RandomAccessIterator, Compare>(job), nthreads);
+    assert(0==job.npending);
+}
+
+/** Stable sort in parallel.  Sorts the values between @p begin (inclusive) and @p end (exclusive) according to the comparator
+ *  @p compare using @p nthreads threads. Values that compare equal keep their relative order, as with std::stable_sort.
+ *
+ *  The values are divided into blocks that are sorted in parallel. Pairs of sorted runs are then merged in parallel, doubling
+ *  the run size each pass, until one run remains.  The merges need temporary storage for a copy of all the values. The
+ *  value type must be copy constructible. The same note about debugging iterators as for quicksort() applies. */
+template<class RandomAccessIterator, class Compare>
+void mergesort(RandomAccessIterator begin, RandomAccessIterator end, Compare compare, size_t nthreads) {
+    assert(begin <= end);
     using namespace Private;
+    typedef typename std::iterator_traits<RandomAccessIterator>::value_type Value;
+    typedef typename std::vector<Value>::iterator BufferIterator;
+    static const size_t minBlockSize = 10000;           // smaller blocks are not worth handing to another thread
+    size_t nvalues = end - begin;
+    nthreads = std::max(nthreads, (size_t)1);
+    if (nvalues < 2)
+        return;
+    if (1==nthreads || nvalues < 2*minBlockSize) {
+        std::stable_sort(begin, end, compare);
+        return;
+    }
 
-    Job<RandomAccessIterator, Compare> job(compare);
-    addWork(job, Work<RandomAccessIterator>(begin, end));
-
-    // Start worker threads (we can't assume containers with move semantics, so use an array)
-    size_t nworkers = std::max(nthreads, (size_t)1) - 1;
-    boost::thread *workers = new boost::thread[nworkers];
-    for (size_t i=0; i<nworkers; ++i)
-        workers[i] = boost::thread(Worker<RandomAccessIterator, Compare>(job, i+1));
-    
-    // Participate in the work ourselves (we might be the only thread!)
-    Worker<RandomAccessIterator, Compare>(job, 0)();
-
-    // Wait for all the threads to finish
-    for (size_t i=0; i<nworkers; ++i)
-        workers[i].join();
+    // One block per thread so that each merge pass has as much parallelism as possible at the start.
+    size_t blockSize = std::max(minBlockSize, (nvalues + nthreads - 1) / nthreads);
+    size_t nblocks = (nvalues + blockSize - 1) / blockSize;
+    runPhase(SortBlock<RandomAccessIterator, Compare>(begin, end, blockSize, compare), nblocks, nthreads);
+
+    // Merge runs back and forth between the values and a buffer.
+    std::vector<Value> buffer(begin, end);
+    bool inBuffer = false;                              // are the current runs in the buffer rather than the values?
+    for (size_t runSize=blockSize; runSize<nvalues; runSize*=2) {
+        size_t nmerges = (nvalues + 2*runSize - 1) / (2*runSize);
+        if (inBuffer) {
+            runPhase(MergeRuns<BufferIterator, RandomAccessIterator, Compare>
+                     (buffer.begin(), buffer.end(), begin, runSize, compare), nmerges, nthreads);
+        } else {
+            runPhase(MergeRuns<RandomAccessIterator, BufferIterator, Compare>
+                     (begin, end, buffer.begin(), runSize, compare), nmerges, nthreads);
+        }
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer)
+        std::copy(buffer.begin(), buffer.end(), begin);
 }
-    
+
 } // namespace
 } // namespace
 